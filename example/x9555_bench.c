@@ -0,0 +1,470 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     WennianYan   the first version.
+ * 2026-10-19     WennianYan   Add two bus benchmark.
+ */
+
+#include "x9555.h"
+
+#ifdef PKG_USING_X9555_EXAMPLE
+
+#define X9555_BENCH_DEVICES_MAX     8
+#define X9555_BENCH_THREADS_MAX     32
+#define X9555_BENCH_BUCKETS         128 // 4 linear steps per power of two
+#define X9555_BENCH_STACK_SIZE      1024
+
+struct x9555_bench_thread
+{
+    x9555_device_t device;
+    rt_sem_t start;
+    rt_sem_t done;
+    rt_bool_t writer;
+    rt_uint8_t pin;
+    rt_uint8_t state;
+    rt_uint32_t ops;
+    rt_uint32_t errors;
+    rt_uint64_t busy;
+    rt_uint32_t histogram[X9555_BENCH_BUCKETS];
+};
+
+static rt_uint8_t x9555_bench_bucket(rt_uint32_t value)
+{
+    rt_uint8_t msb = 0;
+
+    if (value < 4)
+    {
+        return value;
+    }
+    while (value >> (msb + 1))
+    {
+        msb++;
+    }
+    return (msb - 1) * 4 + ((value >> (msb - 2)) & 0x03);
+}
+
+static rt_uint32_t x9555_bench_bucket_value(rt_uint8_t bucket)
+{
+    if (bucket < 4)
+    {
+        return bucket;
+    }
+    return (rt_uint32_t)(4 + (bucket & 0x03)) << (bucket / 4 - 1);
+}
+
+/* bit 0 ~ 7 -> X9555_IO_0_x, bit 8 ~ 15 -> X9555_IO_1_x */
+static rt_uint8_t x9555_bench_pin(rt_uint8_t bit)
+{
+    return (bit < 8) ? (X9555_IO_0_0 + bit) : (X9555_IO_1_0 + bit - 8);
+}
+
+static void x9555_bench_entry(void *parameter)
+{
+    struct x9555_bench_thread *thread = (struct x9555_bench_thread *)parameter;
+    rt_uint32_t start, latency, i;
+    rt_uint32_t ops = thread->ops;
+
+    rt_sem_take(thread->start, RT_WAITING_FOREVER);
+
+    for (i = 0; i < ops; i++)
+    {
+        start = x9555_timestamp_get();
+        if (thread->writer)
+        {
+            thread->state = !thread->state;
+            if (x9555_pin_write(thread->device, thread->pin, thread->state) != RT_EOK)
+            {
+                thread->errors++;
+            }
+        }
+        else
+        {
+            x9555_pin_read(thread->device, thread->pin, X9555_INPUT);
+        }
+        latency = x9555_timestamp_get() - start;
+
+        thread->busy += latency;
+        thread->histogram[x9555_bench_bucket(latency)]++;
+    }
+
+    rt_sem_release(thread->done);
+}
+
+static rt_uint32_t x9555_bench_percentile(const rt_uint32_t *histogram, rt_uint32_t total, rt_uint32_t percent)
+{
+    rt_uint32_t target = (rt_uint32_t)(((rt_uint64_t)total * percent + 99) / 100);
+    rt_uint32_t sum = 0;
+    int bucket;
+
+    for (bucket = 0; bucket < X9555_BENCH_BUCKETS; bucket++)
+    {
+        sum += histogram[bucket];
+        if (sum >= target)
+        {
+            return x9555_timestamp_to_us(x9555_bench_bucket_value(bucket));
+        }
+    }
+    return 0;
+}
+
+/**
+ * Contention benchmark: readers poll input pins, every writer toggles an output pin of its own,
+ * spread over one or more x9555 devices on one I2C bus. It checks the outputs for lost updates
+ * afterwards and reports throughput, call latency and the share of call time spent waiting for
+ * the device lock. Writer pins are driven, run it on a bench board or a simulated bus only,
+ * tools/test/x9555_bench_host.c builds it for the host with the simulated 9555.
+ */
+void x9555_bench(int argc, char *argv[])
+{
+    x9555_device_t devices[X9555_BENCH_DEVICES_MAX] = {RT_NULL};
+    struct x9555_bench_thread *threads;
+    rt_uint32_t *histogram;
+    rt_uint16_t expected_mask[X9555_BENCH_DEVICES_MAX] = {0};
+    rt_uint16_t expected[X9555_BENCH_DEVICES_MAX] = {0};
+    rt_sem_t start, done;
+    rt_thread_t tid;
+    int device_count, readers, writers, thread_count;
+    rt_uint32_t ops, total_ops = 0, errors = 0, lost = 0;
+    rt_uint64_t busy = 0;
+    rt_tick_t elapsed;
+    rt_uint16_t output, shadow;
+    char name[RT_NAME_MAX];
+    int i, d, bucket;
+
+    if (argc < 6)
+    {
+        rt_kprintf("Usage:\n"
+                   "x9555_bench <interrupt pin> <i2c bus> <devices> <readers> <writers> [ops per thread]\n"
+                   "devices use the addresses 0x00 ~ devices - 1, every writer toggles an output pin of its own.\n"
+                   "Example :x9555_bench RT_NULL i2c1 1 4 4 1000\n\n");
+        return;
+    }
+
+    device_count = atoi(argv[3]);
+    readers = atoi(argv[4]);
+    writers = atoi(argv[5]);
+    ops = (argc > 6) ? strtoul(argv[6], RT_NULL, 0) : 1000;
+    thread_count = readers + writers;
+
+    if ((device_count < 1) || (device_count > X9555_BENCH_DEVICES_MAX) || (readers < 0) || (writers < 0) ||
+        (thread_count < 1) || (thread_count > X9555_BENCH_THREADS_MAX) || (writers > device_count * 16))
+    {
+        rt_kprintf("x9555 bench needs 1 ~ %d devices, 1 ~ %d threads and at most 16 writers per device.\n\n",
+                   X9555_BENCH_DEVICES_MAX, X9555_BENCH_THREADS_MAX);
+        return;
+    }
+
+    threads = rt_calloc(thread_count, sizeof(struct x9555_bench_thread));
+    histogram = rt_calloc(X9555_BENCH_BUCKETS, sizeof(rt_uint32_t));
+    start = rt_sem_create("x9555bs", 0, RT_IPC_FLAG_FIFO);
+    done = rt_sem_create("x9555bd", 0, RT_IPC_FLAG_FIFO);
+    if ((threads == RT_NULL) || (histogram == RT_NULL) || (start == RT_NULL) || (done == RT_NULL))
+    {
+        rt_kprintf("x9555 bench out of memory.\n\n");
+        goto __exit;
+    }
+
+    for (d = 0; d < device_count; d++)
+    {
+        devices[d] = x9555_init(argv[1], argv[2], d);
+        if (devices[d] == RT_NULL)
+        {
+            rt_kprintf("x9555 bench can't create device 0x%02x on '%s'.\n\n", d, argv[2]);
+            goto __exit;
+        }
+    }
+
+    /* writer w owns bit w / devices of device w % devices, readers spread over the devices */
+    for (i = 0; i < thread_count; i++)
+    {
+        struct x9555_bench_thread *thread = &threads[i];
+
+        thread->start = start;
+        thread->done = done;
+        thread->ops = ops;
+        thread->writer = (i < writers);
+        if (thread->writer)
+        {
+            d = i % device_count;
+            thread->device = devices[d];
+            thread->pin = x9555_bench_pin(i / device_count);
+            x9555_pin_mode(thread->device, thread->pin, X9555_OUTPUT);
+            expected_mask[d] |= (1 << (i / device_count));
+        }
+        else
+        {
+            thread->device = devices[i % device_count];
+            thread->pin = x9555_bench_pin(i % 16);
+        }
+    }
+
+    for (d = 0; d < device_count; d++)
+    {
+#ifdef PKG_USING_X9555_LOCK_STATS
+        struct x9555_lock_stats lock_stats;
+        x9555_lock_stats_get(devices[d], &lock_stats, RT_TRUE);
+#endif
+        /* the starting level of every writer pin is whatever the shadow holds */
+        for (i = d; i < writers; i += device_count)
+        {
+            threads[i].state = (devices[d]->output_state >> (i / device_count)) & 0x01;
+        }
+    }
+
+    for (i = 0; i < thread_count; i++)
+    {
+        rt_snprintf(name, sizeof(name), "bench%d", i);
+        tid = rt_thread_create(name, x9555_bench_entry, &threads[i], X9555_BENCH_STACK_SIZE,
+                               PKG_X9555_THREAD_PRIORITY + 1, 5);
+        if (tid == RT_NULL)
+        {
+            rt_kprintf("x9555 bench can't create thread %d.\n\n", i);
+            thread_count = i;
+            break;
+        }
+        rt_thread_startup(tid);
+    }
+
+    elapsed = rt_tick_get();
+    for (i = 0; i < thread_count; i++)
+    {
+        rt_sem_release(start);
+    }
+    for (i = 0; i < thread_count; i++)
+    {
+        rt_sem_take(done, RT_WAITING_FOREVER);
+    }
+    elapsed = rt_tick_get() - elapsed;
+
+    for (i = 0; i < thread_count; i++)
+    {
+        total_ops += threads[i].ops;
+        errors += threads[i].errors;
+        busy += threads[i].busy;
+        for (bucket = 0; bucket < X9555_BENCH_BUCKETS; bucket++)
+        {
+            histogram[bucket] += threads[i].histogram[bucket];
+        }
+        if (threads[i].writer)
+        {
+            d = i % device_count;
+            expected[d] |= (rt_uint16_t)threads[i].state << (i / device_count);
+        }
+    }
+
+    rt_kprintf("x9555 bench : %d devices, %d readers, %d writers, %u ops per thread.\n",
+               device_count, readers, writers, ops);
+    rt_kprintf("ops : %u in %u ms, %u ops/s, errors : %u.\n", total_ops, elapsed * 1000 / RT_TICK_PER_SECOND,
+               elapsed ? (rt_uint32_t)((rt_uint64_t)total_ops * RT_TICK_PER_SECOND / elapsed) : 0, errors);
+    rt_kprintf("latency : p50 %u us, p99 %u us.\n",
+               x9555_bench_percentile(histogram, total_ops, 50), x9555_bench_percentile(histogram, total_ops, 99));
+
+    for (d = 0; d < device_count; d++)
+    {
+        /* the chip and the shadow must both hold the last level every writer set */
+        output = x9555_port_read(devices[d], X9555_PORT_0, X9555_OUTPUT) |
+                 (x9555_port_read(devices[d], X9555_PORT_1, X9555_OUTPUT) << 8);
+        shadow = devices[d]->output_state;
+        for (i = 0; i < 16; i++)
+        {
+            if ((expected_mask[d] & (1 << i)) &&
+                (((output ^ expected[d]) & (1 << i)) || ((shadow ^ expected[d]) & (1 << i))))
+            {
+                lost++;
+            }
+        }
+    }
+    rt_kprintf("lost updates : %u.\n", lost);
+
+#ifdef PKG_USING_X9555_LOCK_STATS
+    {
+        struct x9555_lock_stats lock_stats;
+        rt_uint64_t wait_us = 0;
+        rt_uint32_t contended = 0, acquisitions = 0, worst_us = 0;
+
+        for (d = 0; d < device_count; d++)
+        {
+            x9555_lock_stats_get(devices[d], &lock_stats, RT_FALSE);
+            wait_us += lock_stats.wait_us;
+            contended += lock_stats.contended;
+            acquisitions += lock_stats.acquisitions;
+            if (lock_stats.worst_wait_us > worst_us)
+            {
+                worst_us = lock_stats.worst_wait_us;
+            }
+        }
+        busy = (rt_uint64_t)busy * 1000000 / x9555_timestamp_frequency();
+        rt_kprintf("lock : %u of %u takes contended, wait %u%% of call time, worst wait %u us.\n\n",
+                   contended, acquisitions, busy ? (rt_uint32_t)(wait_us * 100 / busy) : 0, worst_us);
+    }
+#else
+    rt_kprintf("lock wait : enable PKG_USING_X9555_LOCK_STATS to measure.\n\n");
+#endif
+
+__exit:
+    for (d = 0; d < X9555_BENCH_DEVICES_MAX; d++)
+    {
+        if (devices[d] != RT_NULL)
+        {
+            x9555_deinit(devices[d]);
+        }
+    }
+    if (done != RT_NULL)
+    {
+        rt_sem_delete(done);
+    }
+    if (start != RT_NULL)
+    {
+        rt_sem_delete(start);
+    }
+    if (histogram != RT_NULL)
+    {
+        rt_free(histogram);
+    }
+    if (threads != RT_NULL)
+    {
+        rt_free(threads);
+    }
+}
+MSH_CMD_EXPORT(x9555_bench, x9555 contention benchmark.);
+
+#ifdef PKG_USING_X9555_BUS_CPU
+/*
+ * runs the threads together and returns the ticks they took. The threads are left where the
+ * scheduler puts them, as an application thread would be, so only the driver binds anything.
+ */
+static rt_tick_t x9555_bench_bus_run(struct x9555_bench_thread *threads, int count)
+{
+    rt_thread_t tid;
+    rt_tick_t elapsed;
+    char name[RT_NAME_MAX];
+    int i, started = 0;
+
+    for (i = 0; i < count; i++)
+    {
+        rt_snprintf(name, sizeof(name), "bench%d", i);
+        tid = rt_thread_create(name, x9555_bench_entry, &threads[i], X9555_BENCH_STACK_SIZE,
+                               PKG_X9555_THREAD_PRIORITY + 1, 5);
+        if (tid == RT_NULL)
+        {
+            rt_kprintf("x9555 bench can't create thread %d.\n\n", i);
+            break;
+        }
+        rt_thread_startup(tid);
+        started++;
+    }
+
+    elapsed = rt_tick_get();
+    for (i = 0; i < started; i++)
+    {
+        rt_sem_release(threads[i].start);
+    }
+    for (i = 0; i < started; i++)
+    {
+        rt_sem_take(threads[i].done, RT_WAITING_FOREVER);
+    }
+
+    return rt_tick_get() - elapsed;
+}
+
+/**
+ * Two bus benchmark: one writer per bus toggles IO_0_0 of the device at address 0x00 through
+ * x9555_pin_write(), first on each bus alone, then on both buses at once, and prints the rates
+ * it measured. The calls run in the unbound writer threads, x9555_bus_cpu_set() only places the
+ * bottom halves, so the rates show what the driver path does and make no claim about scaling.
+ * IO_0_0 is driven, run it on a bench board or a simulated bus only.
+ */
+void x9555_bench_bus(int argc, char *argv[])
+{
+    x9555_device_t devices[2] = {RT_NULL};
+    struct x9555_bench_thread *threads;
+    rt_sem_t start, done;
+    rt_tick_t single[2], both;
+    rt_uint32_t ops, errors = 0;
+    int b;
+
+    if (argc < 3)
+    {
+        rt_kprintf("Usage:\n"
+                   "x9555_bench_bus <i2c bus a> <i2c bus b> [ops per bus]\n"
+                   "the bottom halves run on the bus cores of x9555_bus_cpu_set(), the writers are not bound.\n"
+                   "Example :x9555_bench_bus i2c1 i2c2 10000\n\n");
+        return;
+    }
+
+    ops = (argc > 3) ? strtoul(argv[3], RT_NULL, 0) : 10000;
+
+    threads = rt_calloc(2, sizeof(struct x9555_bench_thread));
+    start = rt_sem_create("x9555bs", 0, RT_IPC_FLAG_FIFO);
+    done = rt_sem_create("x9555bd", 0, RT_IPC_FLAG_FIFO);
+    if ((threads == RT_NULL) || (start == RT_NULL) || (done == RT_NULL))
+    {
+        rt_kprintf("x9555 bench out of memory.\n\n");
+        goto __exit;
+    }
+
+    for (b = 0; b < 2; b++)
+    {
+        devices[b] = x9555_init("RT_NULL", argv[1 + b], 0x00);
+        if (devices[b] == RT_NULL)
+        {
+            rt_kprintf("x9555 bench can't create device 0x00 on '%s'.\n\n", argv[1 + b]);
+            goto __exit;
+        }
+
+        threads[b].device = devices[b];
+        threads[b].start = start;
+        threads[b].done = done;
+        threads[b].ops = ops;
+        threads[b].writer = RT_TRUE;
+        threads[b].pin = X9555_IO_0_0;
+        threads[b].state = devices[b]->output_state & 0x01;
+        x9555_pin_mode(devices[b], X9555_IO_0_0, X9555_OUTPUT);
+    }
+
+    for (b = 0; b < 2; b++)
+    {
+        single[b] = x9555_bench_bus_run(&threads[b], 1);
+    }
+    both = x9555_bench_bus_run(threads, 2);
+
+    for (b = 0; b < 2; b++)
+    {
+        errors += threads[b].errors;
+        rt_kprintf("bus %s, bottom half on cpu %d : %u ops/s alone, %u ticks.\n", argv[1 + b],
+                   x9555_bus_cpu_get(devices[b]),
+                   single[b] ? (rt_uint32_t)((rt_uint64_t)ops * RT_TICK_PER_SECOND / single[b]) : 0, single[b]);
+    }
+
+    rt_kprintf("both buses : %u ops/s, %u ticks, errors : %u.\n\n",
+               both ? (rt_uint32_t)((rt_uint64_t)ops * 2 * RT_TICK_PER_SECOND / both) : 0, both, errors);
+
+__exit:
+    for (b = 0; b < 2; b++)
+    {
+        if (devices[b] != RT_NULL)
+        {
+            x9555_deinit(devices[b]);
+        }
+    }
+    if (done != RT_NULL)
+    {
+        rt_sem_delete(done);
+    }
+    if (start != RT_NULL)
+    {
+        rt_sem_delete(start);
+    }
+    if (threads != RT_NULL)
+    {
+        rt_free(threads);
+    }
+}
+MSH_CMD_EXPORT(x9555_bench_bus, x9555 two bus benchmark.);
+#endif /* PKG_USING_X9555_BUS_CPU */
+
+#endif /* PKG_USING_X9555_EXAMPLE */
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     WennianYan   the first version.
+ */
+
+#include "x9555.hpp"
+
+#ifdef PKG_USING_X9555_EXAMPLE
+
+using x9555::Pin;
+using x9555::Port;
+
+/* two relays on IO_1_3 and IO_1_4, a button on IO_0_0 */
+typedef Pin<Port::P1, 3> relay1_t;
+typedef Pin<Port::P1, 4> relay2_t;
+typedef Pin<Port::P0, 0> button_t;
+
+void x9555_cpp(int argc, char *argv[])
+{
+    x9555_device_t device;
+    bool pressed = false;
+
+    if (argc < 4)
+    {
+        rt_kprintf("Usage:\n"
+                   "x9555_cpp <interrupt pin> <i2c bus> <device address>\n"
+                   "drives IO_1_3 and IO_1_4 together and reads IO_0_0 through the C++ layer.\n"
+                   "Example :x9555_cpp RT_NULL i2c1 0x00\n\n");
+        return;
+    }
+
+    device = x9555_init(argv[1], argv[2], strtoul(argv[3], RT_NULL, 0));
+    if (device == RT_NULL)
+    {
+        rt_kprintf("x9555 cpp can't create device %s on '%s'.\n\n", argv[3], argv[2]);
+        return;
+    }
+
+    relay1_t relay1(device);
+    relay2_t relay2(device);
+    button_t button(device);
+
+    /* each line is one masked driver call */
+    (relay1 | relay2).output();
+    button.input();
+    (relay1 | relay2).set();
+    rt_kprintf("relays on, driven 0x%04x.\n", (relay1 | relay2).driven());
+
+    button.read(pressed);
+    rt_kprintf("button IO_%d_%d is %s.\n", (int)button_t::port, button_t::bit, pressed ? "high" : "low");
+
+    (relay1 | relay2).clear();
+    rt_kprintf("relays off, driven 0x%04x.\n\n", (relay1 | relay2).driven());
+
+    x9555_deinit(device);
+}
+MSH_CMD_EXPORT(x9555_cpp, x9555 C++ pin layer example.);
+
+#endif /* PKG_USING_X9555_EXAMPLE */
@@ -12,6 +12,11 @@
 
 #ifdef PKG_USING_X9555_EXAMPLE
 
+#if defined(PKG_USING_X9555_CAPTURE) && defined(RT_USING_DFS)
+#include <unistd.h>
+#include <fcntl.h>
+#endif
+
 enum N_CARRY
 {
     Binary = 0x00,
@@ -19,6 +24,50 @@ enum N_CARRY
     Hexadecimal = 0x03
 } n_carry;
 
+#ifdef PKG_USING_X9555_CAPTURE
+#define X9555_CAPTURE_RING_MAX      16384 // bytes, 4096 records
+
+/* prints the records while the capture is still running */
+struct x9555_capture_drain
+{
+    struct rt_ringbuffer *ring;
+    volatile rt_bool_t done;
+    struct rt_semaphore exited;
+};
+
+static void x9555_capture_drain_entry(void *parameter)
+{
+    struct x9555_capture_drain *drain = (struct x9555_capture_drain *)parameter;
+    rt_uint8_t record[4];
+    rt_bool_t done;
+
+    do
+    {
+        /* sampled first, every record put before the capture ended is drained below */
+        done = drain->done;
+        while (rt_ringbuffer_get(drain->ring, record, sizeof(record)) == sizeof(record))
+        {
+            rt_kprintf("0x%04x \t %u\n", record[0] | (record[1] << 8), record[2] | (record[3] << 8));
+        }
+        if (!done)
+        {
+            rt_thread_mdelay(1);
+        }
+    } while (!done);
+
+    rt_sem_release(&drain->exited);
+}
+
+#ifdef RT_USING_DFS
+static rt_size_t x9555_capture_file(void *user, const void *data, rt_size_t size)
+{
+    int length = write((int)(rt_base_t)user, data, size);
+
+    return (length < 0) ? 0 : length;
+}
+#endif
+#endif
+
 static void string_to_data(int argc, char *argv[], char (*data_conversion_results)[2])
 {
     char *endptr;
@@ -99,6 +148,16 @@ void x9555(int argc, char *argv[])
                                argv[2], device->device_interrupt_pin,
                                argv[3],
                                *data_conversion_results[4], *data_conversion_results[4], value_to_binary_string);
+#ifdef PKG_USING_X9555_DEVICE
+                    rt_kprintf("device is registered as : %s.\n\n", device->parent.parent.name);
+#endif
+#ifdef PKG_USING_X9555_PIN_OPS
+                    if (x9555_pin_number(device, X9555_IO_0_0) > -1)
+                    {
+                        rt_kprintf("device rt pin numbers : IO_0_0 ~ IO_1_7 -> [%d] ~ [%d].\n\n",
+                                   x9555_pin_number(device, X9555_IO_0_0), x9555_pin_number(device, X9555_IO_1_7));
+                    }
+#endif
                 }
             }
             else
@@ -109,6 +168,34 @@ void x9555(int argc, char *argv[])
                            "--device address is : 0x0[A2 A1 A0]\n\n");
             }
         }
+#ifdef PKG_USING_X9555_BUS_CPU
+        else if (!strcmp(argv[1], "bus_cpu"))
+        {
+            if (argc > 3)
+            {
+                rt_err_t result = x9555_bus_cpu_set(argv[2], atoi(argv[3]));
+
+                if (result == RT_EOK)
+                {
+                    rt_kprintf("x9555 bus '%s' is served on cpu %d.\n\n", argv[2], atoi(argv[3]));
+                }
+                else
+                {
+                    rt_kprintf("x9555 bus '%s' cpu set fail : %d, set it before the first create on the bus.\n\n",
+                               argv[2], result);
+                }
+            }
+            else
+            {
+                rt_kprintf("cmd is : x9555 bus_cpu <i2c bus> <cpu>, cpu %d is unbound.\n\n", X9555_CPU_ANY);
+            }
+        }
+#endif
+        else if (!strcmp(argv[1], "footprint"))
+        {
+            x9555_footprint();
+            rt_kprintf("\n");
+        }
         else
         {
             if (!device)
@@ -251,6 +338,353 @@ void x9555(int argc, char *argv[])
                                *read_buffer, *read_buffer, value_to_binary_string);
                 }
             }
+            else if ((!strcmp(argv[1], "port_write16")) && (argc > 2))
+            {
+                rt_uint16_t port_value = (rt_uint16_t)strtol(argv[2], RT_NULL, 0);
+                rt_uint8_t order = (argc > 3) ? atoi(argv[3]) : X9555_ORDER_PORT_0_FIRST;
+
+                x9555_port_write16(device, port_value, order);
+
+                rt_kprintf("x9555 port write16 done: value 0x%04x, order %d.\n\n", port_value, order);
+            }
+            else if ((!strcmp(argv[1], "poll_period")) && (argc > 2))
+            {
+                x9555_poll_period_set(device, atoi(argv[2]));
+
+                rt_kprintf("x9555 poll period set to %d ms.\n\n", atoi(argv[2]));
+            }
+#ifdef PKG_USING_X9555_BUS_SCHEDULER
+            else if (!strcmp(argv[1], "bus_stats"))
+            {
+                struct x9555_bus_stats stats;
+
+                x9555_bus_stats_get(device, &stats, argc > 2);
+
+                rt_kprintf("x9555 bus '%s' statistics:\n"
+                           "requests : %u, transfers : %u.\n"
+                           "bus lock acquisitions : %u, transfers without own acquisition : %u, lock wait : %u us.\n"
+                           "bus lock held : %u us, transferring : %u us, idle under the lock : %u us.\n\n",
+                           device->i2c->parent.parent.name,
+                           stats.requests, stats.transfers,
+                           stats.batches, stats.requests - stats.batches, stats.lock_us,
+                           stats.busy_us, stats.transfer_us,
+                           (stats.busy_us > stats.transfer_us) ? (stats.busy_us - stats.transfer_us) : 0);
+
+                rt_kprintf("class \t completed \t worst latency\n"
+                           "irq \t %u \t\t %u us\n"
+                           "normal \t %u \t\t %u us\n"
+                           "bulk \t %u \t\t %u us\n\n",
+                           stats.completed[X9555_PRIO_IRQ], stats.worst_latency_us[X9555_PRIO_IRQ],
+                           stats.completed[X9555_PRIO_NORMAL], stats.worst_latency_us[X9555_PRIO_NORMAL],
+                           stats.completed[X9555_PRIO_BULK], stats.worst_latency_us[X9555_PRIO_BULK]);
+            }
+#endif
+#ifdef PKG_USING_X9555_SCRUBBER
+            else if ((!strcmp(argv[1], "scrub")) && (argc > 2))
+            {
+                x9555_scrub_budget_set(device, atoi(argv[2]));
+
+                rt_kprintf("x9555 scrub budget set to %d bytes/s.\n\n", atoi(argv[2]));
+            }
+            else if (!strcmp(argv[1], "scrub_stats"))
+            {
+                struct x9555_scrub_stats stats;
+
+                x9555_scrub_stats_get(device, &stats, argc > 2);
+
+                rt_kprintf("x9555 scrub checks : %u, mismatches : %u, repairs : %u.\n\n",
+                           stats.checks, stats.mismatches, stats.repairs);
+            }
+#endif
+#ifdef PKG_USING_X9555_TRACE
+            else if (!strcmp(argv[1], "trace"))
+            {
+                struct x9555_trace_record *records;
+                rt_size_t len, i;
+                rt_bool_t binary = (argc > 2) && !strcmp(argv[2], "bin");
+
+                if ((argc > 2) && !strcmp(argv[2], "clear"))
+                {
+                    x9555_trace_clear();
+                    rt_kprintf("x9555 trace cleared.\n\n");
+                    return;
+                }
+
+                records = rt_malloc(PKG_X9555_TRACE_DEPTH * sizeof(struct x9555_trace_record));
+                if (records == RT_NULL)
+                {
+                    rt_kprintf("x9555 trace dump out of memory.\n\n");
+                    return;
+                }
+
+                /* the header line carries the timestamp frequency for x9555_replay */
+                len = x9555_trace_snapshot(records, PKG_X9555_TRACE_DEPTH);
+                rt_kprintf("# x9555 trace %u %u%s\n", x9555_timestamp_frequency(), len, binary ? " bin" : "");
+                for (i = 0; i < len; i++)
+                {
+                    if (binary)
+                    {
+                        rt_kprintf("%02x%02x%02x%02x%02x%02x%02x%02x%s",
+                                   records[i].timestamp & 0xff, (records[i].timestamp >> 8) & 0xff,
+                                   (records[i].timestamp >> 16) & 0xff, records[i].timestamp >> 24,
+                                   records[i].addr, records[i].reg, records[i].len, records[i].flags,
+                                   ((i % 4 == 3) || (i == len - 1)) ? "\n" : "");
+                    }
+                    else
+                    {
+                        rt_kprintf("%u 0x%02x 0x%02x %c %u %s\n", records[i].timestamp, records[i].addr, records[i].reg,
+                                   (records[i].flags & X9555_TRACE_READ) ? 'r' : 'w', records[i].len,
+                                   (records[i].flags & X9555_TRACE_ERROR) ? "err" : "ok");
+                    }
+                }
+                rt_kprintf("\n");
+
+                rt_free(records);
+            }
+#endif
+#ifdef PKG_USING_X9555_WRITE_BACK
+            else if ((!strcmp(argv[1], "write_back")) && (argc > 2))
+            {
+                x9555_write_back_set(device, strtoul(argv[2], RT_NULL, 0));
+
+                rt_kprintf("x9555 write-back window set to %s us.\n\n", argv[2]);
+            }
+            else if (!strcmp(argv[1], "flush"))
+            {
+                rt_kprintf("x9555 flush %s.\n\n", (x9555_flush(device) == RT_EOK) ? "done" : "fail");
+            }
+#endif
+#ifdef PKG_USING_X9555_CAPTURE
+            else if ((!strcmp(argv[1], "capture")) && (argc > 2))
+            {
+                struct x9555_capture_stats stats = {0};
+                rt_uint32_t count = strtoul(argv[2], RT_NULL, 0);
+                rt_err_t result;
+
+#ifdef RT_USING_DFS
+                if (argc > 3)
+                {
+                    int fd = open(argv[3], O_WRONLY | O_CREAT | O_TRUNC, 0);
+
+                    if (fd < 0)
+                    {
+                        rt_kprintf("x9555 capture can't open '%s'.\n\n", argv[3]);
+                        return;
+                    }
+                    result = x9555_capture_stream(device, count, x9555_capture_file, (void *)(rt_base_t)fd, &stats);
+                    close(fd);
+                }
+                else
+#endif
+                {
+                    /* one record per sample at worst, the drain thread makes room for longer captures */
+                    rt_uint32_t size = (count < X9555_CAPTURE_RING_MAX / 4) ? (count + 1) * 4 : X9555_CAPTURE_RING_MAX;
+                    struct x9555_capture_drain drain;
+                    rt_thread_t thread;
+
+                    drain.ring = rt_ringbuffer_create(size);
+                    drain.done = RT_FALSE;
+                    if (drain.ring == RT_NULL)
+                    {
+                        rt_kprintf("x9555 capture out of memory.\n\n");
+                        return;
+                    }
+                    rt_sem_init(&drain.exited, "x9555r", 0, RT_IPC_FLAG_FIFO);
+                    thread = rt_thread_create("x9555r", x9555_capture_drain_entry, &drain,
+                                              PKG_X9555_THREAD_STACK_SIZE, PKG_X9555_THREAD_PRIORITY + 1, 10);
+                    if (thread == RT_NULL)
+                    {
+                        rt_kprintf("x9555 capture can't create the drain thread.\n\n");
+                        rt_sem_detach(&drain.exited);
+                        rt_ringbuffer_destroy(drain.ring);
+                        return;
+                    }
+
+                    rt_kprintf("value \t count\n");
+                    rt_thread_startup(thread);
+                    result = x9555_capture_stream(device, count, x9555_capture_ringbuffer, drain.ring, &stats);
+                    drain.done = RT_TRUE;
+                    rt_sem_take(&drain.exited, RT_WAITING_FOREVER);
+                    rt_sem_detach(&drain.exited);
+                    rt_ringbuffer_destroy(drain.ring);
+                }
+
+                rt_kprintf("x9555 capture %s : %u samples in %u reads, %u us, %u samples/s, %u runs, %u bytes.\n\n",
+                           (result == RT_EOK) ? "done" : "fail", stats.samples, stats.reads, stats.elapsed_us,
+                           stats.rate, stats.runs, stats.bytes);
+            }
+#endif
+#ifdef PKG_USING_X9555_IRQ_STORM
+            else if (!strcmp(argv[1], "irq_stats"))
+            {
+                struct x9555_storm_stats stats;
+
+                x9555_storm_stats_get(device, &stats, (argc > 2) && !strcmp(argv[2], "reset"));
+
+                rt_kprintf("x9555 interrupt : %s, to polling %u, to interrupt %u, polls %u.\n\n",
+                           stats.polling ? "polling" : "armed", stats.to_polling, stats.to_interrupt, stats.polls);
+            }
+#endif
+#ifdef PKG_USING_X9555_LATENCY
+            else if (!strcmp(argv[1], "latency"))
+            {
+                struct x9555_latency_stats stats;
+                int bucket;
+
+                x9555_latency_get(device, &stats, (argc > 2) && !strcmp(argv[2], "reset"));
+
+                rt_kprintf("x9555 interrupt latency, timestamp %u Hz:\n", x9555_timestamp_frequency());
+                rt_kprintf("us \t\t wakeup \t read \t\t dispatch \t total\n");
+                for (bucket = 0; bucket < PKG_X9555_LATENCY_BUCKETS; bucket++)
+                {
+                    if (!stats.histogram[X9555_LATENCY_WAKEUP].bucket[bucket] &&
+                        !stats.histogram[X9555_LATENCY_READ].bucket[bucket] &&
+                        !stats.histogram[X9555_LATENCY_DISPATCH].bucket[bucket] &&
+                        !stats.histogram[X9555_LATENCY_TOTAL].bucket[bucket])
+                    {
+                        continue;
+                    }
+                    rt_kprintf("%s%u \t\t %u \t\t %u \t\t %u \t\t %u\n",
+                               (bucket == PKG_X9555_LATENCY_BUCKETS - 1) ? ">=" : "", (bucket == 0) ? 0 : (1UL << bucket),
+                               stats.histogram[X9555_LATENCY_WAKEUP].bucket[bucket],
+                               stats.histogram[X9555_LATENCY_READ].bucket[bucket],
+                               stats.histogram[X9555_LATENCY_DISPATCH].bucket[bucket],
+                               stats.histogram[X9555_LATENCY_TOTAL].bucket[bucket]);
+                }
+                rt_kprintf("max \t\t %u \t\t %u \t\t %u \t\t %u\n"
+                           "count \t\t %u\n\n",
+                           stats.histogram[X9555_LATENCY_WAKEUP].max_us, stats.histogram[X9555_LATENCY_READ].max_us,
+                           stats.histogram[X9555_LATENCY_DISPATCH].max_us, stats.histogram[X9555_LATENCY_TOTAL].max_us,
+                           stats.histogram[X9555_LATENCY_TOTAL].count);
+            }
+#endif
+#ifdef PKG_USING_X9555_PIN_GROUP
+            else if ((!strcmp(argv[1], "group")) && (argc > 3))
+            {
+                struct x9555_group_pin pins[16];
+                x9555_pin_group_t group;
+                rt_uint32_t value;
+                int i, count = argc - 3;
+
+                if (count > 16)
+                {
+                    count = 16;
+                }
+                for (i = 0; i < count; i++)
+                {
+                    pins[i].device = device;
+                    pins[i].pin = atoi(argv[3 + i]);
+                }
+
+                group = x9555_pin_group_create(pins, count);
+                if (group != RT_NULL)
+                {
+                    if (!strcmp(argv[2], "read"))
+                    {
+                        x9555_pin_group_read(group, &value);
+                        rt_kprintf("x9555 pin group read : 0x%x.\n\n", value);
+                    }
+                    else
+                    {
+                        value = strtoul(argv[2], RT_NULL, 0);
+                        x9555_pin_group_write(group, value);
+                        rt_kprintf("x9555 pin group write : 0x%x.\n\n", value);
+                    }
+                    x9555_pin_group_delete(group);
+                }
+            }
+#endif
+#ifdef PKG_USING_X9555_PIN_WAIT
+            else if ((!strcmp(argv[1], "pin_wait")) && (argc > 4))
+            {
+                rt_uint16_t pin_mask = (rt_uint16_t)strtol(argv[2], RT_NULL, 0);
+                rt_uint16_t level_mask = (rt_uint16_t)strtol(argv[3], RT_NULL, 0);
+                rt_int32_t timeout = rt_tick_from_millisecond(atoi(argv[4]));
+                rt_bool_t any = (argc > 5) && !strcmp(argv[5], "any");
+                rt_err_t result;
+
+                result = any ? x9555_pin_wait_any(device, pin_mask, level_mask, timeout)
+                             : x9555_pin_wait(device, pin_mask, level_mask, timeout);
+
+                rt_kprintf("x9555 pin wait %s: pins 0x%04x, levels 0x%04x, inputs 0x%04x.\n\n",
+                           (result == RT_EOK) ? "done" : "timeout", pin_mask, level_mask, device->input_state);
+            }
+#endif
+#ifdef PKG_USING_X9555_EVENT_RING
+            else if (!strcmp(argv[1], "events"))
+            {
+                struct x9555_input_event events[8];
+                rt_int32_t timeout = RT_WAITING_NO;
+                rt_size_t len, i;
+
+                if (argc > 2)
+                {
+                    timeout = rt_tick_from_millisecond(atoi(argv[2]));
+                }
+
+                while ((len = x9555_event_read(device, events, 8, timeout)) > 0)
+                {
+                    for (i = 0; i < len; i++)
+                    {
+                        rt_kprintf("[%10u] 0x%04x -> 0x%04x\n", events[i].tick, events[i].old_value, events[i].new_value);
+                    }
+                    timeout = RT_WAITING_NO;
+                }
+
+                rt_kprintf("x9555 events dropped : %u.\n\n", x9555_event_dropped(device));
+            }
+#endif
+#ifdef PKG_USING_X9555_EDGE_COUNTER
+            else if ((!strcmp(argv[1], "edge_config")) && (argc > 3))
+            {
+                x9555_edge_counter_config(device, *data_conversion_results[2], *data_conversion_results[3]);
+
+                rt_kprintf("x9555 pin %d edge counter set to %d.\n\n", *data_conversion_results[2], *data_conversion_results[3]);
+            }
+            else if ((!strcmp(argv[1], "edge_read")) && (argc > 2))
+            {
+                rt_uint32_t count = x9555_edge_counter_read(device, *data_conversion_results[2], argc > 3);
+                rt_uint32_t frequency = x9555_edge_frequency_get(device, *data_conversion_results[2]);
+
+                rt_kprintf("x9555 pin %d edges : %u, frequency : %u.%03u Hz.\n\n", *data_conversion_results[2],
+                           count, frequency / 1000, frequency % 1000);
+            }
+#endif
+#ifdef PKG_USING_X9555_SOFT_PWM
+            else if ((!strcmp(argv[1], "pwm_config")) && (argc > 3))
+            {
+                if (x9555_pwm_config(device, atoi(argv[2]), atoi(argv[3])) == RT_EOK)
+                {
+                    rt_kprintf("x9555 pwm config done: %d Hz, %d steps.\n\n", atoi(argv[2]), atoi(argv[3]));
+                }
+            }
+            else if ((!strcmp(argv[1], "pwm_set")) && (argc > 3))
+            {
+                if (x9555_pwm_set(device, *data_conversion_results[2], atoi(argv[3])) == RT_EOK)
+                {
+                    rt_kprintf("x9555 pwm pin %d duty set to %d.\n\n", *data_conversion_results[2], atoi(argv[3]));
+                }
+            }
+            else if (!strcmp(argv[1], "pwm_start"))
+            {
+                x9555_pwm_start(device);
+            }
+            else if (!strcmp(argv[1], "pwm_stop"))
+            {
+                x9555_pwm_stop(device);
+            }
+            else if (!strcmp(argv[1], "pwm_load"))
+            {
+                struct x9555_pwm_load load;
+
+                if (x9555_pwm_bus_load(device, &load) == RT_EOK)
+                {
+                    rt_kprintf("x9555 pwm bus load : %u writes/s, %u bytes/s.\n"
+                               "x9555 pwm writes : %u, late edges : %u.\n\n",
+                               load.writes_per_second, load.bytes_per_second, load.writes, load.late);
+                }
+            }
+#endif
             else
             {
                 rt_kprintf("command don't found or not enough parameters. Please enter 'x9555' for help.\n\n");
@@ -272,7 +706,55 @@ void x9555(int argc, char *argv[])
         rt_kprintf("x9555 port_read <port> <port mode> \t\t\t\t - get x9555 port input.\n");
         rt_kprintf("x9555 pin_mode <pin> <pin mode> \t\t\t\t - set x9555 io mode.\n");
         rt_kprintf("x9555 pin_write <pin> <pin state> \t\t\t\t - set x9555 io output.\n");
-        rt_kprintf("x9555 pin_read <pin> <pin mode> \t\t\t\t - get x9555 io input.\n\n");
+        rt_kprintf("x9555 pin_read <pin> <pin mode> \t\t\t\t - get x9555 io input.\n");
+        rt_kprintf("x9555 port_write16 <value> [order] \t\t\t\t - set both x9555 ports in one transaction.\n");
+        rt_kprintf("x9555 poll_period <ms> \t\t\t\t\t - set x9555 input poll period, 0 is off.\n");
+        rt_kprintf("x9555 footprint \t\t\t\t\t - print the x9555 object sizes of this build.\n");
+#ifdef PKG_USING_X9555_BUS_SCHEDULER
+        rt_kprintf("x9555 bus_stats [reset] \t\t\t\t\t - get x9555 i2c bus transaction statistics.\n");
+#endif
+#ifdef PKG_USING_X9555_SCRUBBER
+        rt_kprintf("x9555 scrub <bytes/s> \t\t\t\t\t - set x9555 register scrub budget, 0 is off.\n");
+        rt_kprintf("x9555 scrub_stats [reset] \t\t\t\t - get x9555 register scrub statistics.\n");
+#endif
+#ifdef PKG_USING_X9555_TRACE
+        rt_kprintf("x9555 trace [bin | clear] \t\t\t\t - dump x9555 i2c transaction trace.\n");
+#endif
+#ifdef PKG_USING_X9555_WRITE_BACK
+        rt_kprintf("x9555 write_back <window us> \t\t\t\t - hold back x9555 writes for a window, 0 is off.\n");
+        rt_kprintf("x9555 flush \t\t\t\t\t\t - send x9555 held back writes now.\n");
+#endif
+#ifdef PKG_USING_X9555_CAPTURE
+        rt_kprintf("x9555 capture <samples> [file] \t\t\t\t - capture x9555 inputs run-length compressed.\n");
+#endif
+#ifdef PKG_USING_X9555_BUS_CPU
+        rt_kprintf("x9555 bus_cpu <i2c bus> <cpu> \t\t\t\t - serve an x9555 i2c bus on a cpu, before create.\n");
+#endif
+#ifdef PKG_USING_X9555_IRQ_STORM
+        rt_kprintf("x9555 irq_stats [reset] \t\t\t\t\t - get x9555 interrupt storm switches.\n");
+#endif
+#ifdef PKG_USING_X9555_LATENCY
+        rt_kprintf("x9555 latency [reset] \t\t\t\t\t - get x9555 interrupt latency histograms.\n");
+#endif
+#ifdef PKG_USING_X9555_PIN_GROUP
+        rt_kprintf("x9555 group <value | read> <pin> [pin ...] \t\t - write or read x9555 pins as one value, first pin is bit 0.\n");
+#endif
+#ifdef PKG_USING_X9555_PIN_WAIT
+        rt_kprintf("x9555 pin_wait <pin mask> <level mask> <timeout ms> [any] \t - wait for x9555 input pins.\n");
+#endif
+#ifdef PKG_USING_X9555_EVENT_RING
+        rt_kprintf("x9555 events [timeout ms] \t\t\t\t - dump x9555 input change events.\n");
+#endif
+#ifdef PKG_USING_X9555_EDGE_COUNTER
+        rt_kprintf("x9555 edge_config <pin> <edge> \t\t\t\t - count x9555 pin edges, 0 off 1 rising 2 falling 3 both.\n");
+        rt_kprintf("x9555 edge_read <pin> [reset] \t\t\t\t - get x9555 pin edge count and frequency.\n");
+#endif
+#ifdef PKG_USING_X9555_SOFT_PWM
+        rt_kprintf("x9555 pwm_config <frequency> <resolution> \t\t - config x9555 soft pwm.\n");
+        rt_kprintf("x9555 pwm_set <pin> <duty> \t\t\t\t - set x9555 pwm channel duty.\n");
+        rt_kprintf("x9555 pwm_start | pwm_stop | pwm_load \t\t\t - control x9555 soft pwm.\n");
+#endif
+        rt_kprintf("\n");
 
         rt_kprintf("X9555 Register:\n"
                    "X9555_Register_Input_Port_0 \t\t\t 0x00\n"
@@ -298,6 +780,11 @@ void x9555(int argc, char *argv[])
                    "X9555_INPUT \t\t\t 0x01\n"
                    "X9555_POLARITY_INVERSION \t 0x02\n\n");
 
+        rt_kprintf("X9555 Write Order:\n"
+                   "X9555_ORDER_PORT_0_FIRST \t 0x00\n"
+                   "X9555_ORDER_PORT_1_FIRST \t 0x01\n"
+                   "X9555_ORDER_CHANGED_ONLY \t 0x02\n\n");
+
         rt_kprintf("X9555 IO PORT 0:\n"
                    "X9555_IO_0_0 \t\t 0\n"
                    "X9555_IO_0_1 \t\t 1\n"
@@ -0,0 +1,22 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     WennianYan   the first version.
+ */
+
+#ifndef __RT_DBG_H__
+#define __RT_DBG_H__
+
+#include <rtthread.h>
+
+/* the host tests print errors only */
+#define LOG_E(...)              do { rt_kprintf(__VA_ARGS__); rt_kprintf("\n"); } while (0)
+#define LOG_W(...)
+#define LOG_I(...)
+#define LOG_D(...)
+
+#endif
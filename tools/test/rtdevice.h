@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     WennianYan   the first version.
+ */
+
+/* host stand-in of the I2C and pin driver API used by x9555.c, see rtthread.h */
+
+#ifndef __RT_DEVICE_H__
+#define __RT_DEVICE_H__
+
+#include <rtthread.h>
+
+#define RT_I2C_WR               0x0000
+#define RT_I2C_RD               (1u << 0)
+
+struct rt_i2c_msg
+{
+    rt_uint16_t addr;
+    rt_uint16_t flags;
+    rt_uint16_t len;
+    rt_uint8_t  *buf;
+};
+
+struct rt_i2c_bus_device
+{
+    struct rt_object parent;
+};
+
+struct rt_i2c_bus_device *rt_i2c_bus_device_find(const char *bus_name);
+rt_ssize_t rt_i2c_transfer(struct rt_i2c_bus_device *bus, struct rt_i2c_msg msgs[], rt_uint32_t num);
+
+#define PIN_LOW                 0x00
+#define PIN_HIGH                0x01
+
+#define PIN_MODE_OUTPUT         0x00
+#define PIN_MODE_INPUT          0x01
+#define PIN_MODE_INPUT_PULLUP   0x02
+#define PIN_MODE_INPUT_PULLDOWN 0x03
+#define PIN_MODE_OUTPUT_OD      0x04
+
+#define PIN_IRQ_MODE_RISING         0x00
+#define PIN_IRQ_MODE_FALLING        0x01
+#define PIN_IRQ_MODE_RISING_FALLING 0x02
+#define PIN_IRQ_MODE_HIGH_LEVEL     0x03
+#define PIN_IRQ_MODE_LOW_LEVEL      0x04
+#define PIN_IRQ_DISABLE             0x00
+#define PIN_IRQ_ENABLE              0x01
+#define PIN_IRQ_PIN_NONE            -1
+
+struct rt_pin_irq_hdr
+{
+    rt_base_t pin;
+    rt_uint8_t mode;
+    void (*hdr)(void *args);
+    void *args;
+};
+
+struct rt_pin_ops
+{
+    void (*pin_mode)(struct rt_device *device, rt_base_t pin, rt_uint8_t mode);
+    void (*pin_write)(struct rt_device *device, rt_base_t pin, rt_uint8_t value);
+    rt_ssize_t (*pin_read)(struct rt_device *device, rt_base_t pin);
+    rt_err_t (*pin_attach_irq)(struct rt_device *device, rt_base_t pin, rt_uint8_t mode, void (*hdr)(void *args), void *args);
+    rt_err_t (*pin_detach_irq)(struct rt_device *device, rt_base_t pin);
+    rt_err_t (*pin_irq_enable)(struct rt_device *device, rt_base_t pin, rt_uint8_t enabled);
+    rt_base_t (*pin_get)(const char *name);
+};
+
+struct rt_device_pin
+{
+    struct rt_device parent;
+    const struct rt_pin_ops *ops;
+};
+
+rt_base_t rt_pin_get(const char *name);
+void rt_pin_mode(rt_base_t pin, rt_uint8_t mode);
+rt_err_t rt_pin_attach_irq(rt_base_t pin, rt_uint8_t mode, void (*hdr)(void *args), void *args);
+rt_err_t rt_pin_detach_irq(rt_base_t pin);
+rt_err_t rt_pin_irq_enable(rt_base_t pin, rt_uint8_t enabled);
+
+#endif
@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     WennianYan   the first version.
+ */
+
+/*
+ * Host stand-in of the RT-Thread kernel API used by x9555.c with the default config and with
+ * PKG_USING_X9555_PIN_OPS, and by example/x9555_bench.c, for the host targets. Single threaded: the
+ * threads of x9555.c are never run, other threads run to completion one after another when a caller
+ * would block on a semaphore, IPC never blocks.
+ */
+
+#ifndef __RTTHREAD_H__
+#define __RTTHREAD_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <assert.h>
+
+typedef int8_t                  rt_int8_t;
+typedef uint8_t                 rt_uint8_t;
+typedef int16_t                 rt_int16_t;
+typedef uint16_t                rt_uint16_t;
+typedef int32_t                 rt_int32_t;
+typedef uint32_t                rt_uint32_t;
+typedef int64_t                 rt_int64_t;
+typedef uint64_t                rt_uint64_t;
+typedef int                     rt_bool_t;
+typedef long                    rt_base_t;
+typedef unsigned long           rt_ubase_t;
+typedef rt_base_t               rt_err_t;
+typedef rt_uint32_t             rt_tick_t;
+typedef rt_ubase_t              rt_size_t;
+typedef rt_base_t               rt_ssize_t;
+typedef rt_base_t               rt_off_t;
+typedef rt_base_t               rt_atomic_t;
+
+#define RT_TRUE                 1
+#define RT_FALSE                0
+#define RT_NULL                 0
+
+#define RT_EOK                  0
+#define RT_ERROR                1
+#define RT_ETIMEOUT             2
+#define RT_EFULL                3
+#define RT_EEMPTY               4
+#define RT_ENOMEM               5
+#define RT_ENOSYS               6
+#define RT_EBUSY                7
+#define RT_EIO                  8
+#define RT_EINTR                9
+#define RT_EINVAL               10
+
+#define RT_WAITING_FOREVER      -1
+#define RT_WAITING_NO           0
+#define RT_TICK_PER_SECOND      1000
+#define RT_NAME_MAX             8
+
+#define RT_IPC_FLAG_FIFO        0x00
+#define RT_IPC_FLAG_PRIO        0x01
+#define RT_EVENT_FLAG_AND       0x01
+#define RT_EVENT_FLAG_OR        0x02
+#define RT_EVENT_FLAG_CLEAR     0x04
+
+#define RT_ASSERT(EX)           assert(EX)
+#define rt_inline               static __inline
+
+#define MSH_CMD_EXPORT(command, desc)
+#define INIT_PREV_EXPORT(fn)
+#define MSH_CMD_EXPORT_ALIAS(command, alias, desc)
+
+struct rt_list_node
+{
+    struct rt_list_node *next;
+    struct rt_list_node *prev;
+};
+typedef struct rt_list_node rt_list_t;
+
+#define RT_LIST_OBJECT_INIT(object) { &(object), &(object) }
+
+#define rt_container_of(ptr, type, member) \
+    ((type *)((char *)(ptr) - (unsigned long)(&((type *)0)->member)))
+#define rt_list_entry(node, type, member) rt_container_of(node, type, member)
+#define rt_list_first_entry(ptr, type, member) rt_list_entry((ptr)->next, type, member)
+#define rt_list_for_each_entry(pos, head, member) \
+    for (pos = rt_list_entry((head)->next, __typeof__(*pos), member); \
+         &pos->member != (head); \
+         pos = rt_list_entry(pos->member.next, __typeof__(*pos), member))
+
+rt_inline void rt_list_init(rt_list_t *l)
+{
+    l->next = l->prev = l;
+}
+
+rt_inline void rt_list_insert_before(rt_list_t *l, rt_list_t *n)
+{
+    l->prev->next = n;
+    n->prev = l->prev;
+    l->prev = n;
+    n->next = l;
+}
+
+rt_inline void rt_list_remove(rt_list_t *n)
+{
+    n->next->prev = n->prev;
+    n->prev->next = n->next;
+    n->next = n->prev = n;
+}
+
+rt_inline int rt_list_isempty(const rt_list_t *l)
+{
+    return l->next == l;
+}
+
+struct rt_object
+{
+    char name[RT_NAME_MAX];
+};
+
+struct rt_mutex
+{
+    struct rt_object parent;
+    rt_uint8_t hold;
+};
+typedef struct rt_mutex *rt_mutex_t;
+
+struct rt_event
+{
+    struct rt_object parent;
+    rt_uint32_t set;
+};
+typedef struct rt_event *rt_event_t;
+
+struct rt_semaphore
+{
+    struct rt_object parent;
+    rt_uint16_t value;
+};
+typedef struct rt_semaphore *rt_sem_t;
+
+struct rt_thread
+{
+    struct rt_object parent;
+    void (*entry)(void *parameter);
+    void *parameter;
+    rt_list_t tlist;
+};
+typedef struct rt_thread *rt_thread_t;
+
+struct rt_spinlock
+{
+    rt_ubase_t lock;
+};
+
+struct rt_device
+{
+    struct rt_object parent;
+};
+typedef struct rt_device *rt_device_t;
+
+rt_err_t rt_mutex_init(rt_mutex_t mutex, const char *name, rt_uint8_t flag);
+rt_err_t rt_mutex_detach(rt_mutex_t mutex);
+rt_err_t rt_mutex_take(rt_mutex_t mutex, rt_int32_t time);
+rt_err_t rt_mutex_release(rt_mutex_t mutex);
+
+rt_err_t rt_event_init(rt_event_t event, const char *name, rt_uint8_t flag);
+rt_err_t rt_event_detach(rt_event_t event);
+rt_event_t rt_event_create(const char *name, rt_uint8_t flag);
+rt_err_t rt_event_delete(rt_event_t event);
+rt_err_t rt_event_send(rt_event_t event, rt_uint32_t set);
+rt_err_t rt_event_recv(rt_event_t event, rt_uint32_t set, rt_uint8_t opt, rt_int32_t timeout, rt_uint32_t *recved);
+
+rt_sem_t rt_sem_create(const char *name, rt_uint32_t value, rt_uint8_t flag);
+rt_err_t rt_sem_delete(rt_sem_t sem);
+rt_err_t rt_sem_take(rt_sem_t sem, rt_int32_t time);
+rt_err_t rt_sem_release(rt_sem_t sem);
+
+rt_thread_t rt_thread_create(const char *name, void (*entry)(void *parameter), void *parameter,
+                             rt_uint32_t stack_size, rt_uint8_t priority, rt_uint32_t tick);
+rt_err_t rt_thread_startup(rt_thread_t thread);
+rt_thread_t rt_thread_self(void);
+
+rt_tick_t rt_tick_get(void);
+rt_tick_t rt_tick_from_millisecond(rt_int32_t ms);
+
+rt_device_t rt_device_find(const char *name);
+
+void rt_spin_lock_init(struct rt_spinlock *lock);
+rt_base_t rt_spin_lock_irqsave(struct rt_spinlock *lock);
+void rt_spin_unlock_irqrestore(struct rt_spinlock *lock, rt_base_t level);
+
+void rt_enter_critical(void);
+void rt_exit_critical(void);
+
+void *rt_calloc(rt_size_t count, rt_size_t size);
+void rt_free(void *ptr);
+void *rt_memset(void *s, int c, rt_ubase_t count);
+void *rt_memcpy(void *dst, const void *src, rt_ubase_t count);
+void rt_kprintf(const char *fmt, ...);
+int rt_snprintf(char *buf, rt_size_t size, const char *fmt, ...);
+
+#endif
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     WennianYan   the first version.
+ */
+
+/*
+ * Host target of example/x9555_bench.c. The bench and x9555.c are built with the default config
+ * against the stand-in headers of this directory, the devices are the simulated 9555 on "i2c1".
+ * The bench threads run one after another, so the host rates are the cost of the driver path on
+ * the simulated bus, with no lock contention; the lost update check runs as on the target.
+ *
+ * build : cc -O2 -I tools/test -I . -DPKG_USING_X9555 -DPKG_USING_X9555_EXAMPLE -o x9555_bench_host \
+ *         tools/test/x9555_bench_host.c tools/test/x9555_host.c example/x9555_bench.c x9555.c
+ * usage : x9555_bench_host [devices] [readers] [writers] [ops per thread], default 2 4 4 1000
+ */
+
+#include "x9555.h"
+#include "x9555_host.h"
+
+#include <time.h>
+
+extern void x9555_bench(int argc, char *argv[]);
+
+/* microseconds of the wall clock, the latency histogram needs a finer base than the tick */
+rt_uint32_t x9555_timestamp_get(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (rt_uint32_t)((rt_uint64_t)now.tv_sec * 1000000 + now.tv_nsec / 1000);
+}
+
+rt_uint32_t x9555_timestamp_frequency(void)
+{
+    return 1000000;
+}
+
+int main(int argc, char *argv[])
+{
+    char *bench_argv[7] = {"x9555_bench", "RT_NULL", "i2c1", "2", "4", "4", "1000"};
+    int i;
+
+    for (i = 1; (i < argc) && (i < 5); i++)
+    {
+        bench_argv[2 + i] = argv[i];
+    }
+    for (i = 0; i < HOST_CHIP_MAX; i++)
+    {
+        sim_reset(&host_chips[i]);
+    }
+
+    x9555_bench(7, bench_argv);
+    return 0;
+}
@@ -0,0 +1,358 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     WennianYan   the first version.
+ */
+
+/*
+ * single threaded stand-ins of x9555_host.h. The threads x9555.c creates, named "x9555...", are never
+ * run. Any other thread runs to completion when a caller would block on a semaphore, in the order the
+ * threads were started.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <time.h>
+
+#include "x9555_host.h"
+
+#define HOST_DEVICE_MAX 4
+
+struct sim_9555 host_chips[HOST_CHIP_MAX];
+host_stop_hook_t host_stop_hook;
+uint32_t host_failures;
+
+static struct rt_i2c_bus_device host_bus;
+static struct rt_thread host_thread;
+static rt_list_t host_ready = RT_LIST_OBJECT_INIT(host_ready);
+static rt_device_t host_devices[HOST_DEVICE_MAX];
+
+rt_err_t rt_mutex_init(rt_mutex_t mutex, const char *name, rt_uint8_t flag)
+{
+    mutex->hold = 0;
+    return RT_EOK;
+}
+
+rt_err_t rt_mutex_detach(rt_mutex_t mutex)
+{
+    RT_ASSERT(mutex->hold == 0);
+    return RT_EOK;
+}
+
+rt_err_t rt_mutex_take(rt_mutex_t mutex, rt_int32_t time)
+{
+    mutex->hold++;
+    return RT_EOK;
+}
+
+rt_err_t rt_mutex_release(rt_mutex_t mutex)
+{
+    RT_ASSERT(mutex->hold > 0);
+    mutex->hold--;
+    return RT_EOK;
+}
+
+rt_err_t rt_event_init(rt_event_t event, const char *name, rt_uint8_t flag)
+{
+    event->set = 0;
+    return RT_EOK;
+}
+
+rt_err_t rt_event_detach(rt_event_t event)
+{
+    return RT_EOK;
+}
+
+rt_event_t rt_event_create(const char *name, rt_uint8_t flag)
+{
+    return calloc(1, sizeof(struct rt_event));
+}
+
+rt_err_t rt_event_delete(rt_event_t event)
+{
+    free(event);
+    return RT_EOK;
+}
+
+rt_err_t rt_event_send(rt_event_t event, rt_uint32_t set)
+{
+    event->set |= set;
+    return RT_EOK;
+}
+
+/* nothing else runs to send what is missing, so it never waits */
+rt_err_t rt_event_recv(rt_event_t event, rt_uint32_t set, rt_uint8_t opt, rt_int32_t timeout, rt_uint32_t *recved)
+{
+    rt_uint32_t got = event->set & set;
+
+    if ((got == 0) || ((opt & RT_EVENT_FLAG_AND) && (got != set)))
+    {
+        return -RT_ETIMEOUT;
+    }
+    if (opt & RT_EVENT_FLAG_CLEAR)
+    {
+        event->set &= ~got;
+    }
+    if (recved)
+    {
+        *recved = got;
+    }
+    return RT_EOK;
+}
+
+rt_sem_t rt_sem_create(const char *name, rt_uint32_t value, rt_uint8_t flag)
+{
+    rt_sem_t sem = calloc(1, sizeof(struct rt_semaphore));
+
+    if (sem != RT_NULL)
+    {
+        sem->value = value;
+    }
+    return sem;
+}
+
+rt_err_t rt_sem_delete(rt_sem_t sem)
+{
+    free(sem);
+    return RT_EOK;
+}
+
+/* instead of blocking, the started threads run until one of them releases the semaphore */
+rt_err_t rt_sem_take(rt_sem_t sem, rt_int32_t time)
+{
+    rt_thread_t thread;
+
+    while ((sem->value == 0) && !rt_list_isempty(&host_ready))
+    {
+        thread = rt_list_first_entry(&host_ready, struct rt_thread, tlist);
+        rt_list_remove(&thread->tlist);
+        thread->entry(thread->parameter);
+        free(thread);
+    }
+
+    if (sem->value == 0)
+    {
+        RT_ASSERT(time != RT_WAITING_FOREVER);
+        return -RT_ETIMEOUT;
+    }
+    sem->value--;
+    return RT_EOK;
+}
+
+rt_err_t rt_sem_release(rt_sem_t sem)
+{
+    sem->value++;
+    return RT_EOK;
+}
+
+rt_thread_t rt_thread_create(const char *name, void (*entry)(void *parameter), void *parameter,
+                             rt_uint32_t stack_size, rt_uint8_t priority, rt_uint32_t tick)
+{
+    rt_thread_t thread = &host_thread;
+
+    if (strncmp(name, "x9555", 5) != 0)
+    {
+        thread = calloc(1, sizeof(struct rt_thread));
+        if (thread == RT_NULL)
+        {
+            return RT_NULL;
+        }
+        strncpy(thread->parent.name, name, RT_NAME_MAX - 1);
+    }
+    thread->entry = entry;
+    thread->parameter = parameter;
+    rt_list_init(&thread->tlist);
+    return thread;
+}
+
+rt_err_t rt_thread_startup(rt_thread_t thread)
+{
+    if (thread != &host_thread)
+    {
+        rt_list_insert_before(&host_ready, &thread->tlist);
+    }
+    return RT_EOK;
+}
+
+/* the caller is never one of the threads x9555.c creates */
+rt_thread_t rt_thread_self(void)
+{
+    return RT_NULL;
+}
+
+/* the wall clock, so the bench rates are real */
+rt_tick_t rt_tick_get(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (rt_tick_t)((rt_uint64_t)now.tv_sec * RT_TICK_PER_SECOND + now.tv_nsec / (1000000000 / RT_TICK_PER_SECOND));
+}
+
+rt_tick_t rt_tick_from_millisecond(rt_int32_t ms)
+{
+    return (rt_tick_t)ms;
+}
+
+void rt_spin_lock_init(struct rt_spinlock *lock)
+{
+    lock->lock = 0;
+}
+
+rt_base_t rt_spin_lock_irqsave(struct rt_spinlock *lock)
+{
+    RT_ASSERT(lock->lock == 0);
+    lock->lock = 1;
+    return 0;
+}
+
+void rt_spin_unlock_irqrestore(struct rt_spinlock *lock, rt_base_t level)
+{
+    RT_ASSERT(lock->lock == 1);
+    lock->lock = 0;
+}
+
+void rt_enter_critical(void)
+{
+}
+
+void rt_exit_critical(void)
+{
+}
+
+void *rt_calloc(rt_size_t count, rt_size_t size)
+{
+    return calloc(count, size);
+}
+
+void rt_free(void *ptr)
+{
+    free(ptr);
+}
+
+void *rt_memset(void *s, int c, rt_ubase_t count)
+{
+    return memset(s, c, count);
+}
+
+void *rt_memcpy(void *dst, const void *src, rt_ubase_t count)
+{
+    return memcpy(dst, src, count);
+}
+
+void rt_kprintf(const char *fmt, ...)
+{
+    va_list args;
+
+    va_start(args, fmt);
+    vprintf(fmt, args);
+    va_end(args);
+}
+
+int rt_snprintf(char *buf, rt_size_t size, const char *fmt, ...)
+{
+    va_list args;
+    int len;
+
+    va_start(args, fmt);
+    len = vsnprintf(buf, size, fmt, args);
+    va_end(args);
+    return len;
+}
+
+rt_device_t rt_device_find(const char *name)
+{
+    int i;
+
+    for (i = 0; i < HOST_DEVICE_MAX; i++)
+    {
+        if ((host_devices[i] != RT_NULL) && (strcmp(host_devices[i]->parent.name, name) == 0))
+        {
+            return host_devices[i];
+        }
+    }
+    return RT_NULL;
+}
+
+void host_device_add(rt_device_t device, const char *name)
+{
+    int i;
+
+    for (i = 0; i < HOST_DEVICE_MAX; i++)
+    {
+        if (host_devices[i] == RT_NULL)
+        {
+            strncpy(device->parent.name, name, RT_NAME_MAX - 1);
+            host_devices[i] = device;
+            return;
+        }
+    }
+    RT_ASSERT(0);
+}
+
+struct rt_i2c_bus_device *rt_i2c_bus_device_find(const char *bus_name)
+{
+    return strcmp(bus_name, "i2c1") ? RT_NULL : &host_bus;
+}
+
+/* one call is one transaction, start to stop */
+rt_ssize_t rt_i2c_transfer(struct rt_i2c_bus_device *bus, struct rt_i2c_msg msgs[], rt_uint32_t num)
+{
+    struct sim_9555 *chip;
+    rt_uint32_t i;
+
+    if ((msgs[0].addr < X9555_ADDR_BASE) || (msgs[0].addr >= X9555_ADDR_BASE + HOST_CHIP_MAX))
+    {
+        return -RT_EIO;
+    }
+    chip = &host_chips[msgs[0].addr - X9555_ADDR_BASE];
+
+    chip->transfers++;
+    for (i = 0; i < num; i++)
+    {
+        if (msgs[i].flags & RT_I2C_RD)
+        {
+            sim_data(chip, msgs[i].buf, msgs[i].len, 1);
+        }
+        else if ((msgs[i].len > 0) && (sim_command(chip, msgs[i].buf[0]) == 0))
+        {
+            sim_data(chip, msgs[i].buf + 1, msgs[i].len - 1, 0);
+        }
+    }
+
+    if (host_stop_hook)
+    {
+        host_stop_hook(chip);
+    }
+    return num;
+}
+
+rt_base_t rt_pin_get(const char *name)
+{
+    return -1;
+}
+
+void rt_pin_mode(rt_base_t pin, rt_uint8_t mode)
+{
+}
+
+rt_err_t rt_pin_attach_irq(rt_base_t pin, rt_uint8_t mode, void (*hdr)(void *args), void *args)
+{
+    return -RT_ENOSYS;
+}
+
+rt_err_t rt_pin_detach_irq(rt_base_t pin)
+{
+    return RT_EOK;
+}
+
+rt_err_t rt_pin_irq_enable(rt_base_t pin, rt_uint8_t enabled)
+{
+    return RT_EOK;
+}
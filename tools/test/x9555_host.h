@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     WennianYan   the first version.
+ */
+
+/*
+ * Kernel, I2C and pin stand-ins shared by the host targets. Bus "i2c1" carries HOST_CHIP_MAX
+ * simulated 9555 at the addresses 0x00 ~ HOST_CHIP_MAX - 1 (0x20 ~ 0x27 on the wire), the threads
+ * x9555.c creates never run.
+ */
+
+#ifndef __X9555_HOST_H__
+#define __X9555_HOST_H__
+
+#include <stdio.h>
+#include <rtthread.h>
+#include <rtdevice.h>
+
+#include "../x9555_sim.h"
+
+/* called at the stop of every transaction on the simulated chip */
+typedef void (*host_stop_hook_t)(struct sim_9555 *chip);
+
+#define HOST_CHIP_MAX 8
+
+extern struct sim_9555 host_chips[HOST_CHIP_MAX];
+/* the chip at address 0x00 */
+#define host_chip (host_chips[0])
+extern host_stop_hook_t host_stop_hook;
+
+/* makes a device visible to rt_device_find(), up to 4 */
+void host_device_add(rt_device_t device, const char *name);
+
+#define CHECK(cond, ...)                               \
+    do                                                 \
+    {                                                  \
+        if (!(cond))                                   \
+        {                                              \
+            printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+            printf(__VA_ARGS__);                       \
+            printf("\n");                              \
+            host_failures++;                           \
+        }                                              \
+    } while (0)
+
+extern uint32_t host_failures;
+
+#endif
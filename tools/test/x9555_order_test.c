@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     WennianYan   the first version.
+ */
+
+/*
+ * Host test of the 16-bit output writes. x9555.c is built with the default config against the
+ * stand-in headers of this directory, its I2C transfers run through the simulated 9555 of
+ * x9555_sim.h, which logs the pins after every data byte it latches and at every stop.
+ *
+ * build : cc -O2 -I tools/test -I . -DPKG_USING_X9555 -o x9555_order_test tools/test/x9555_order_test.c \
+ *         tools/test/x9555_host.c x9555.c
+ * usage : x9555_order_test, run from anywhere, exits non-zero when a check fails
+ */
+
+#include "x9555.h"
+#include "x9555_host.h"
+
+#define LOG_MAX 64
+
+/* one data byte latched by an output register */
+struct byte_record
+{
+    uint32_t transfer;
+    uint8_t reg;
+    uint8_t value;
+    uint16_t output;          // the pins right after the byte
+};
+
+static struct byte_record bytes[LOG_MAX];
+static uint32_t byte_count;
+static uint32_t stop_bytes;      // byte_count at the last stop
+static uint16_t stops[LOG_MAX];  // the pins at the stop of each transfer that wrote an output
+static uint32_t stop_count;
+
+static void output_hook(struct sim_9555 *sim, uint8_t reg)
+{
+    if (((reg == 2) || (reg == 3)) && (byte_count < LOG_MAX))
+    {
+        bytes[byte_count].transfer = sim->transfers;
+        bytes[byte_count].reg = reg;
+        bytes[byte_count].value = sim->regs[reg];
+        bytes[byte_count].output = sim_output16(sim);
+        byte_count++;
+    }
+}
+
+static void stop_hook(struct sim_9555 *sim)
+{
+    if ((byte_count != stop_bytes) && (stop_count < LOG_MAX))
+    {
+        stops[stop_count++] = sim_output16(sim);
+    }
+    stop_bytes = byte_count;
+}
+
+static void log_clear(void)
+{
+    byte_count = 0;
+    stop_bytes = 0;
+    stop_count = 0;
+}
+
+/* the pins between two transactions are only ever the old or the new value */
+static uint32_t mixed_stops(uint16_t old_value, uint16_t new_value)
+{
+    uint32_t i, mixed = 0;
+
+    for (i = 0; i < stop_count; i++)
+    {
+        if ((stops[i] != old_value) && (stops[i] != new_value))
+        {
+            mixed++;
+        }
+    }
+    return mixed;
+}
+
+/* one step from old_value to new_value, checked byte by byte against the expected wire order */
+static void check_step(x9555_device_t device, uint16_t old_value, uint16_t new_value, rt_uint8_t order,
+                       const uint8_t *regs, uint32_t count)
+{
+    uint32_t i;
+
+    CHECK(x9555_port_write16(device, old_value, X9555_ORDER_PORT_0_FIRST) == RT_EOK, "setup write");
+    CHECK(sim_output16(&host_chip) == old_value, "setup 0x%04x, pins 0x%04x", old_value, sim_output16(&host_chip));
+    log_clear();
+
+    CHECK(x9555_port_write16(device, new_value, order) == RT_EOK, "write 0x%04x order %d", new_value, order);
+
+    CHECK(stop_count == ((count > 0) ? 1 : 0), "0x%04x -> 0x%04x order %d: %u transactions, want %u",
+          old_value, new_value, order, stop_count, (count > 0) ? 1 : 0);
+    CHECK(byte_count == count, "0x%04x -> 0x%04x order %d: %u bytes, want %u",
+          old_value, new_value, order, byte_count, count);
+
+    for (i = 0; (i < byte_count) && (i < count); i++)
+    {
+        uint8_t want = (regs[i] == 2) ? (new_value & 0xff) : (new_value >> 8);
+
+        CHECK(bytes[i].reg == regs[i], "byte %u went to register %d, want %d", i, bytes[i].reg, regs[i]);
+        CHECK(bytes[i].value == want, "byte %u is 0x%02x, want 0x%02x", i, bytes[i].value, want);
+        CHECK(bytes[i].transfer == bytes[0].transfer, "byte %u is in another transaction", i);
+    }
+
+    /* the one intermediate state lasts a byte time, inside the transaction */
+    if (count == 2)
+    {
+        uint16_t between = (regs[0] == 2) ? ((old_value & 0xff00) | (new_value & 0x00ff))
+                                          : ((new_value & 0xff00) | (old_value & 0x00ff));
+
+        CHECK(bytes[0].output == between, "intermediate 0x%04x, want 0x%04x", bytes[0].output, between);
+    }
+
+    CHECK(mixed_stops(old_value, new_value) == 0, "0x%04x -> 0x%04x order %d: mixed state between transactions",
+          old_value, new_value, order);
+    CHECK(sim_output16(&host_chip) == new_value, "pins 0x%04x, want 0x%04x", sim_output16(&host_chip), new_value);
+    CHECK(device->output_state == new_value, "shadow 0x%04x, want 0x%04x", device->output_state, new_value);
+}
+
+int main(int argc, char *argv[])
+{
+    static const uint8_t port_0_first[] = {2, 3};
+    static const uint8_t port_1_first[] = {3, 2};
+    static const uint8_t port_0_only[] = {2};
+    static const uint8_t port_1_only[] = {3};
+    static const uint16_t gray[] = {0x0000, 0x0001, 0x0101, 0x0100, 0x8100, 0x8180, 0x0080, 0x0000};
+    x9555_device_t device;
+    uint32_t i;
+
+    sim_reset(&host_chip);
+    host_chip.hook = output_hook;
+    host_stop_hook = stop_hook;
+
+    device = x9555_init("RT_NULL", "i2c1", 0x00);
+    if (device == RT_NULL)
+    {
+        printf("FAIL x9555_init\n");
+        return 1;
+    }
+
+    /* both ports in one transaction, in the requested order */
+    check_step(device, 0x1234, 0xabcd, X9555_ORDER_PORT_0_FIRST, port_0_first, 2);
+    check_step(device, 0x1234, 0xabcd, X9555_ORDER_PORT_1_FIRST, port_1_first, 2);
+    check_step(device, 0x1234, 0xabcd, X9555_ORDER_CHANGED_ONLY, port_0_first, 2);
+
+    /* a port that keeps its value is not sent */
+    check_step(device, 0x1234, 0x12cd, X9555_ORDER_CHANGED_ONLY, port_0_only, 1);
+    check_step(device, 0x1234, 0xab34, X9555_ORDER_CHANGED_ONLY, port_1_only, 1);
+    check_step(device, 0x1234, 0x1234, X9555_ORDER_CHANGED_ONLY, port_0_only, 0);
+
+    /* a Gray-coded walk across both ports never shows a value off the walk */
+    CHECK(x9555_port_write16(device, gray[0], X9555_ORDER_PORT_0_FIRST) == RT_EOK, "gray setup");
+    log_clear();
+    for (i = 1; i < sizeof(gray) / sizeof(gray[0]); i++)
+    {
+        CHECK(x9555_port_write16(device, gray[i], X9555_ORDER_CHANGED_ONLY) == RT_EOK, "gray step %u", i);
+        CHECK(stops[stop_count - 1] == gray[i], "gray step %u: pins 0x%04x", i, stops[stop_count - 1]);
+    }
+    CHECK(byte_count == stop_count, "gray walk: %u bytes in %u transactions", byte_count, stop_count);
+
+    /* the checker itself: two single-port writes leave a mixed state between the transactions */
+    CHECK(x9555_port_write16(device, 0x1234, X9555_ORDER_PORT_0_FIRST) == RT_EOK, "split setup");
+    log_clear();
+    CHECK(x9555_port_write(device, X9555_PORT_0, 0xcd) == RT_EOK, "split write port 0");
+    CHECK(x9555_port_write(device, X9555_PORT_1, 0xab) == RT_EOK, "split write port 1");
+    CHECK(mixed_stops(0x1234, 0xabcd) == 1, "split write: the mixed state 0x12cd was not seen");
+
+    x9555_deinit(device);
+
+    if (host_failures)
+    {
+        printf("%u checks failed\n", host_failures);
+        return 1;
+    }
+    printf("x9555 order test passed\n");
+    return 0;
+}
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     WennianYan   the first version.
+ */
+
+/*
+ * Host test of the rt_pin_mode() mapping of PKG_USING_X9555_PIN_OPS. A stand-in MCU "pin" device
+ * records what reaches it, the x9555 pins are checked in the configuration registers of the
+ * simulated 9555.
+ *
+ * build : cc -O2 -I tools/test -I . -DPKG_USING_X9555 -DPKG_USING_X9555_PIN_OPS -o x9555_pin_ops_test \
+ *         tools/test/x9555_pin_ops_test.c tools/test/x9555_host.c x9555.c
+ * usage : x9555_pin_ops_test, run from anywhere, exits non-zero when a check fails
+ */
+
+#include "x9555.h"
+#include "x9555_host.h"
+
+#define MCU_PIN_NUM 16
+
+static rt_uint8_t mcu_modes[MCU_PIN_NUM];
+
+static void mcu_pin_mode(struct rt_device *device, rt_base_t pin, rt_uint8_t mode)
+{
+    if ((pin >= 0) && (pin < MCU_PIN_NUM))
+    {
+        mcu_modes[pin] = mode;
+    }
+}
+
+static void mcu_pin_write(struct rt_device *device, rt_base_t pin, rt_uint8_t value)
+{
+}
+
+static rt_ssize_t mcu_pin_read(struct rt_device *device, rt_base_t pin)
+{
+    return PIN_LOW;
+}
+
+static const struct rt_pin_ops mcu_pin_ops =
+{
+    mcu_pin_mode,
+    mcu_pin_write,
+    mcu_pin_read,
+    RT_NULL,
+    RT_NULL,
+    RT_NULL,
+    RT_NULL,
+};
+
+static struct rt_device_pin mcu_pin = { {{{0}}}, &mcu_pin_ops };
+
+/* 1 when the x9555 pin of bit 0 ~ 15 is an input */
+static int chip_input(rt_uint8_t bit)
+{
+    return (host_chip.regs[6 + bit / 8] >> (bit % 8)) & 0x01;
+}
+
+/* one rt_pin_mode() through the wrapped ops, then the configuration bit of the pin */
+static void check_mode(rt_uint8_t bit, rt_uint8_t mode, int input)
+{
+    mcu_pin.ops->pin_mode(&mcu_pin.parent, PKG_X9555_PIN_BASE + bit, mode);
+    CHECK(chip_input(bit) == input, "bit %d mode %d: %s, want %s", bit, mode,
+          chip_input(bit) ? "input" : "output", input ? "input" : "output");
+}
+
+int main(int argc, char *argv[])
+{
+    x9555_device_t device;
+    rt_uint8_t bit;
+
+    sim_reset(&host_chip);
+    host_device_add(&mcu_pin.parent, "pin");
+
+    device = x9555_init("RT_NULL", "i2c1", 0x00);
+    if (device == RT_NULL)
+    {
+        printf("FAIL x9555_init\n");
+        return 1;
+    }
+    CHECK(mcu_pin.ops != &mcu_pin_ops, "the pin ops were not wrapped");
+
+    for (bit = 0; bit < 16; bit += 7)
+    {
+        check_mode(bit, PIN_MODE_OUTPUT, 0);
+        check_mode(bit, PIN_MODE_INPUT, 1);
+        check_mode(bit, PIN_MODE_OUTPUT_OD, 0);
+
+        /* every 9555 input has its 100 kohm pull-up, the most common input mode must work */
+        check_mode(bit, PIN_MODE_INPUT_PULLUP, 1);
+
+        /* nothing pulls down, the pin keeps its mode */
+        check_mode(bit, PIN_MODE_INPUT_PULLDOWN, 1);
+        check_mode(bit, PIN_MODE_OUTPUT, 0);
+        check_mode(bit, PIN_MODE_INPUT_PULLDOWN, 0);
+    }
+    CHECK(device->config_state == ((host_chip.regs[7] << 8) | host_chip.regs[6]), "shadow 0x%04x, chip 0x%02x%02x",
+          device->config_state, host_chip.regs[7], host_chip.regs[6]);
+
+    /* pins below PKG_X9555_PIN_BASE still reach the MCU driver unchanged */
+    mcu_pin.ops->pin_mode(&mcu_pin.parent, 3, PIN_MODE_INPUT_PULLDOWN);
+    CHECK(mcu_modes[3] == PIN_MODE_INPUT_PULLDOWN, "MCU pin 3 mode %d", mcu_modes[3]);
+
+    x9555_deinit(device);
+
+    if (host_failures)
+    {
+        printf("%u checks failed\n", host_failures);
+        return 1;
+    }
+    printf("x9555 pin ops test passed\n");
+    return 0;
+}
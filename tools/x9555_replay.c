@@ -0,0 +1,326 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     WennianYan   the first version.
+ */
+
+/*
+ * Host tool, replays an `x9555 trace` dump (text or bin) against simulated 9555 chips on a
+ * simulated I2C bus, to reproduce traffic volume and bus timing problems on a desk.
+ *
+ * build : cc -O2 -o x9555_replay x9555_replay.c
+ * usage : x9555_replay [-c bus clock Hz] [-w window ms] [-v] [dump file]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "x9555_sim.h"
+
+#define X9555_TRACE_READ    0x01
+#define X9555_TRACE_ERROR   0x02
+
+struct trace_record
+{
+    uint32_t timestamp;
+    uint8_t addr;
+    uint8_t reg;
+    uint8_t len;
+    uint8_t flags;
+};
+
+static struct sim_9555 chips[X9555_ADDR_NUM];
+static uint32_t foreign;
+
+static const char *reg_names[X9555_REG_NUM] =
+{
+    "input 0", "input 1", "output 0", "output 1",
+    "polarity 0", "polarity 1", "config 0", "config 1"
+};
+
+static int hex_byte(const char *s)
+{
+    unsigned int value;
+
+    if (sscanf(s, "%2x", &value) != 1)
+    {
+        return -1;
+    }
+    return (int)value;
+}
+
+/* returns the number of records parsed from one line */
+static int parse_line(const char *line, int binary, struct trace_record *records, int max)
+{
+    unsigned int timestamp, addr, reg, len;
+    char dir, result[8];
+    int count = 0, i, b[8];
+
+    if (!binary)
+    {
+        if (sscanf(line, "%u %x %x %c %u %7s", &timestamp, &addr, &reg, &dir, &len, result) != 6)
+        {
+            return 0;
+        }
+        records[0].timestamp = timestamp;
+        records[0].addr = (uint8_t)addr;
+        records[0].reg = (uint8_t)reg;
+        records[0].len = (uint8_t)len;
+        records[0].flags = ((dir == 'r') ? X9555_TRACE_READ : 0) | (strcmp(result, "ok") ? X9555_TRACE_ERROR : 0);
+        return 1;
+    }
+
+    while ((count < max) && (strlen(line) >= 16))
+    {
+        for (i = 0; i < 8; i++)
+        {
+            b[i] = hex_byte(line + i * 2);
+            if (b[i] < 0)
+            {
+                return count;
+            }
+        }
+        records[count].timestamp = (uint32_t)b[0] | ((uint32_t)b[1] << 8) | ((uint32_t)b[2] << 16) | ((uint32_t)b[3] << 24);
+        records[count].addr = (uint8_t)b[4];
+        records[count].reg = (uint8_t)b[5];
+        records[count].len = (uint8_t)b[6];
+        records[count].flags = (uint8_t)b[7];
+        count++;
+        line += 16;
+    }
+    return count;
+}
+
+/* start, command, repeated start for reads, 9 clocks per byte, stop */
+static uint32_t transfer_bits(const struct trace_record *record)
+{
+    if (record->flags & X9555_TRACE_READ)
+    {
+        return 1 + 2 * 9 + 1 + (1 + record->len) * 9 + 1;
+    }
+    return 1 + (2 + record->len) * 9 + 1;
+}
+
+static void sim_transfer(const struct trace_record *record)
+{
+    struct sim_9555 *chip;
+
+    if ((record->addr < X9555_ADDR_BASE) || (record->addr >= X9555_ADDR_BASE + X9555_ADDR_NUM))
+    {
+        foreign++;
+        return;
+    }
+
+    chip = &chips[record->addr - X9555_ADDR_BASE];
+    chip->transfers++;
+    chip->bytes += record->len;
+    if (record->flags & X9555_TRACE_ERROR)
+    {
+        chip->errors++;
+        return;
+    }
+    if (sim_command(chip, record->reg) != 0)
+    {
+        return;
+    }
+
+    sim_data(chip, NULL, record->len, record->flags & X9555_TRACE_READ);
+}
+
+static void usage(const char *name)
+{
+    fprintf(stderr, "usage: %s [-c bus clock Hz] [-w window ms] [-v] [dump file]\n", name);
+    exit(1);
+}
+
+int main(int argc, char *argv[])
+{
+    struct trace_record line_records[16];
+    struct trace_record *records = NULL;
+    size_t count = 0, capacity = 0;
+    unsigned long clock = 100000, window_ms = 10;
+    unsigned long frequency = 0;
+    int verbose = 0, binary = 0;
+    const char *path = NULL;
+    char line[512];
+    FILE *file = stdin;
+    int i, n;
+
+    for (i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "-c") && (i + 1 < argc))
+        {
+            clock = strtoul(argv[++i], NULL, 0);
+        }
+        else if (!strcmp(argv[i], "-w") && (i + 1 < argc))
+        {
+            window_ms = strtoul(argv[++i], NULL, 0);
+        }
+        else if (!strcmp(argv[i], "-v"))
+        {
+            verbose = 1;
+        }
+        else if (argv[i][0] == '-')
+        {
+            usage(argv[0]);
+        }
+        else
+        {
+            path = argv[i];
+        }
+    }
+    if ((clock == 0) || (window_ms == 0))
+    {
+        usage(argv[0]);
+    }
+
+    if (path != NULL)
+    {
+        file = fopen(path, "r");
+        if (file == NULL)
+        {
+            perror(path);
+            return 1;
+        }
+    }
+
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        if (!strncmp(line, "# x9555 trace", 13))
+        {
+            binary = (strstr(line, " bin") != NULL);
+            frequency = strtoul(line + 13, NULL, 10);
+            continue;
+        }
+
+        n = parse_line(line, binary, line_records, 16);
+        if (n == 0)
+        {
+            continue;
+        }
+        if (count + n > capacity)
+        {
+            capacity = (capacity == 0) ? 256 : capacity * 2;
+            records = realloc(records, capacity * sizeof(struct trace_record));
+            if (records == NULL)
+            {
+                fprintf(stderr, "out of memory\n");
+                return 1;
+            }
+        }
+        memcpy(&records[count], line_records, n * sizeof(struct trace_record));
+        count += n;
+    }
+    if (file != stdin)
+    {
+        fclose(file);
+    }
+
+    if ((frequency == 0) || (count == 0))
+    {
+        fprintf(stderr, "no trace header or no records found\n");
+        free(records);
+        return 1;
+    }
+
+    /*
+     * The recorded timestamps are taken as the times the transfers were issued. Each transfer then
+     * waits for the simulated bus, so the delay shows how far behind the traffic falls at this clock.
+     */
+    {
+        double now_us = 0, bus_free_us = 0, start_us, duration_us, delay_us;
+        double busy_us = 0, delay_sum_us = 0, delay_max_us = 0;
+        double window_start_us = 0, window_busy_us = 0, window_max = 0;
+        uint64_t elapsed = 0;
+        uint32_t bytes = 0;
+        size_t k;
+
+        for (k = 0; k < count; k++)
+        {
+            if (k > 0)
+            {
+                /* the timestamp is a free running 32-bit counter */
+                elapsed += (uint32_t)(records[k].timestamp - records[k - 1].timestamp);
+            }
+            now_us = (double)elapsed * 1000000.0 / frequency;
+
+            duration_us = transfer_bits(&records[k]) * 1000000.0 / clock;
+            start_us = (now_us > bus_free_us) ? now_us : bus_free_us;
+            delay_us = start_us - now_us;
+            bus_free_us = start_us + duration_us;
+
+            busy_us += duration_us;
+            delay_sum_us += delay_us;
+            if (delay_us > delay_max_us)
+            {
+                delay_max_us = delay_us;
+            }
+
+            while (start_us >= window_start_us + window_ms * 1000.0)
+            {
+                if (window_busy_us / (window_ms * 1000.0) > window_max)
+                {
+                    window_max = window_busy_us / (window_ms * 1000.0);
+                }
+                window_start_us += window_ms * 1000.0;
+                window_busy_us = 0;
+            }
+            window_busy_us += duration_us;
+
+            bytes += records[k].len;
+            sim_transfer(&records[k]);
+
+            if (verbose)
+            {
+                printf("%12.1f us  0x%02x %c reg 0x%02x len %3u %-3s  bus %7.1f us  wait %9.1f us\n",
+                       now_us, records[k].addr, (records[k].flags & X9555_TRACE_READ) ? 'r' : 'w', records[k].reg,
+                       records[k].len, (records[k].flags & X9555_TRACE_ERROR) ? "err" : "ok", duration_us, delay_us);
+            }
+        }
+        if (window_busy_us / (window_ms * 1000.0) > window_max)
+        {
+            window_max = window_busy_us / (window_ms * 1000.0);
+        }
+
+        printf("records          : %lu over %.3f ms, timestamp %lu Hz\n",
+               (unsigned long)count, now_us / 1000.0, frequency);
+        printf("data bytes       : %u, %.1f bytes/s\n", bytes, (now_us > 0) ? bytes * 1000000.0 / now_us : 0.0);
+        printf("bus clock        : %lu Hz, busy %.3f ms, utilization %.1f %%\n",
+               clock, busy_us / 1000.0, (bus_free_us > 0) ? busy_us * 100.0 / bus_free_us : 0.0);
+        printf("busiest %3lu ms   : %.1f %%\n", window_ms, window_max * 100.0);
+        printf("bus wait         : avg %.1f us, max %.1f us\n", delay_sum_us / count, delay_max_us);
+    }
+
+    for (i = 0; i < X9555_ADDR_NUM; i++)
+    {
+        struct sim_9555 *chip = &chips[i];
+
+        if (chip->transfers == 0)
+        {
+            continue;
+        }
+
+        printf("\nx9555 0x%02x : %u transfers, %u data bytes, %u errors, %u invalid commands\n",
+               X9555_ADDR_BASE + i, chip->transfers, chip->bytes, chip->errors, chip->invalid);
+        for (n = 0; n < X9555_REG_NUM; n++)
+        {
+            if (chip->reads[n] || chip->writes[n])
+            {
+                printf("  %-10s  read %8u  write %8u\n", reg_names[n], chip->reads[n], chip->writes[n]);
+            }
+        }
+    }
+    if (foreign)
+    {
+        printf("\n%u transfers to addresses outside 0x20 ~ 0x27\n", foreign);
+    }
+
+    free(records);
+    return 0;
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     WennianYan   the first version.
+ */
+
+/*
+ * Simulated 9555 of the host tools. x9555_replay feeds it trace records, which have no data
+ * bytes, the host tests feed it the messages of rt_i2c_transfer() and read the pins back.
+ */
+
+#ifndef __X9555_SIM_H__
+#define __X9555_SIM_H__
+
+#include <stdint.h>
+
+#define X9555_ADDR_BASE     0x20
+#define X9555_ADDR_NUM      8
+#define X9555_REG_NUM       8
+
+struct sim_9555;
+
+/* called after each data byte written, with the register it landed in */
+typedef void (*sim_byte_hook_t)(struct sim_9555 *chip, uint8_t reg);
+
+/* what a 9555 sees: a command byte sets the register pointer, which toggles inside a register pair */
+struct sim_9555
+{
+    uint8_t regs[X9555_REG_NUM];
+    uint8_t pointer;
+    sim_byte_hook_t hook;
+    uint32_t reads[X9555_REG_NUM];
+    uint32_t writes[X9555_REG_NUM];
+    uint32_t transfers;
+    uint32_t bytes;
+    uint32_t errors;
+    uint32_t invalid;
+};
+
+/* the state after power on */
+static inline void sim_reset(struct sim_9555 *chip)
+{
+    uint8_t i;
+
+    for (i = 0; i < X9555_REG_NUM; i++)
+    {
+        chip->regs[i] = (i < 4) ? 0xff : ((i < 6) ? 0x00 : 0xff);
+    }
+    chip->pointer = 0;
+}
+
+/* command byte, returns -1 for a register the chip does not have */
+static inline int sim_command(struct sim_9555 *chip, uint8_t reg)
+{
+    if (reg >= X9555_REG_NUM)
+    {
+        chip->invalid++;
+        return -1;
+    }
+    chip->pointer = reg;
+    return 0;
+}
+
+/* len data bytes at the register pointer, data is NULL when only the traffic is known */
+static inline void sim_data(struct sim_9555 *chip, uint8_t *data, uint32_t len, int read)
+{
+    uint32_t i;
+
+    for (i = 0; i < len; i++)
+    {
+        if (read)
+        {
+            chip->reads[chip->pointer]++;
+            if (data)
+            {
+                data[i] = chip->regs[chip->pointer];
+            }
+        }
+        else
+        {
+            chip->writes[chip->pointer]++;
+            /* the input registers ignore writes */
+            if (data && (chip->pointer >= 2))
+            {
+                chip->regs[chip->pointer] = data[i];
+                if (chip->hook)
+                {
+                    chip->hook(chip, chip->pointer);
+                }
+            }
+        }
+        chip->pointer ^= 0x01;
+    }
+}
+
+/* the 16-bit output the pins show, port 1 in the high byte */
+static inline uint16_t sim_output16(const struct sim_9555 *chip)
+{
+    return (uint16_t)(chip->regs[2] | (chip->regs[3] << 8));
+}
+
+#endif
@@ -7,624 +7,4830 @@
  * Date           Author       Notes
  * 2023-10-01     WennianYan   the first version.
  * 2023-10-23     WennianYan   Update the package framework.
+ * 2026-10-19     WennianYan   Add interrupt bottom half and input event ring.
+ * 2026-10-19     WennianYan   Add input edge counters.
+ * 2026-10-19     WennianYan   Add register shadow and soft PWM.
+ * 2026-10-19     WennianYan   Add per-bus transaction combiner.
+ * 2026-10-19     WennianYan   Add bus priority classes and output bursts.
+ * 2026-10-19     WennianYan   Add register scrubber.
+ * 2026-10-19     WennianYan   Add I2C transaction trace.
+ * 2026-10-19     WennianYan   Add device lock statistics.
+ * 2026-10-19     WennianYan   Add blocking pin condition wait.
+ * 2026-10-19     WennianYan   Add pin groups.
+ * 2026-10-19     WennianYan   Add interrupt latency histograms, cycle counter time base.
+ * 2026-10-19     WennianYan   Add write-back mode.
+ * 2026-10-19     WennianYan   Add interrupt-safe pin APIs.
+ * 2026-10-19     WennianYan   Add interrupt storm protection.
+ * 2026-10-19     WennianYan   Add shared worker pool.
+ * 2026-10-19     WennianYan   Add input capture.
+ * 2026-10-19     WennianYan   Add rt_device registration.
+ * 2026-10-19     WennianYan   Add pin framework integration.
+ * 2026-10-19     WennianYan   Add per-bus cpu binding.
+ * 2026-10-19     WennianYan   Add masked mode and 16-bit input read for the C++ layer.
  */
 
 #include "x9555.h"
 
 #ifdef PKG_USING_X9555
 
+#if defined(PKG_USING_X9555_DEVICE) && defined(RT_USING_POSIX_DEVIO)
+#include <dfs_file.h>
+#include <poll.h>
+#endif
+
+#if (PKG_X9555_EVENT_RING_DEPTH & (PKG_X9555_EVENT_RING_DEPTH - 1)) != 0
+#error "PKG_X9555_EVENT_RING_DEPTH must be a power of two"
+#endif
+
+#if (PKG_X9555_TRACE_DEPTH & (PKG_X9555_TRACE_DEPTH - 1)) != 0
+#error "PKG_X9555_TRACE_DEPTH must be a power of two"
+#endif
+
+#if (PKG_X9555_CAPTURE_CHUNK < 1) || (PKG_X9555_CAPTURE_CHUNK > 127)
+#error "PKG_X9555_CAPTURE_CHUNK must be 1 ~ 127, a chunk is one read of up to 254 bytes"
+#endif
+
+/* Cortex-M3 and up with CMSIS have a cycle counter in the DWT */
+#if defined(DWT_CTRL_CYCCNTENA_Msk) && defined(CoreDebug_DEMCR_TRCENA_Msk)
+#define X9555_USING_DWT
+#endif
+
+/* worker event set */
+#define X9555_EVENT_IRQ         (1 << 0)
+#define X9555_EVENT_WAKE        (1 << 1)
+#define X9555_EVENT_EXIT        (1 << 2)
+#define X9555_EVENT_EXITED      (1 << 3)
+#define X9555_EVENT_PWM         (1 << 4)
+#define X9555_EVENT_SCRUB       (1 << 5)
+#define X9555_EVENT_FLUSH       (1 << 6)
+#define X9555_EVENT_OUTPUT      (1 << 7)
+
+static rt_err_t x9555_worker_notify(x9555_device_t device, rt_uint32_t flags);
+
 /****************************************************************************************/
 
-static rt_err_t x9555_read_one_byte(x9555_device_t device, rt_uint8_t register_address,
-                                    rt_uint8_t *read_register_value)
+static rt_uint16_t *x9555_shadow_get(x9555_device_t device, rt_uint8_t register_address)
 {
-    if (rt_i2c_master_send(device->i2c, device->device_address, RT_NULL, &register_address, 1) == 1)
+    switch (register_address & ~0x01)
     {
-        if (rt_i2c_master_recv(device->i2c, device->device_address, RT_NULL, read_register_value, 1) == 1)
-        {
-            return RT_EOK;
-        }
+    case X9555_Register_Output_Port_0:
+        return &device->output_state;
+    case X9555_Register_Polarity_Inversion_Port_0:
+        return &device->polarity_state;
+    case X9555_Register_Configuration_Port_0:
+        return &device->config_state;
+    default:
+        return RT_NULL;
     }
-    return -RT_ERROR;
 }
 
-static rt_err_t x9555_write_one_byte(x9555_device_t device, rt_uint8_t register_address,
-                                     rt_uint8_t send_register_value)
+/* keep the register shadow in step with what has been written to the chip */
+static void x9555_shadow_update(x9555_device_t device, rt_uint8_t register_address, rt_uint8_t register_value)
 {
-    rt_uint8_t buf[2];
-
-    buf[0] = register_address;
-    buf[1] = send_register_value;
+    rt_uint16_t *state = x9555_shadow_get(device, register_address);
+    rt_uint8_t shift = (register_address & 0x01) * 8;
 
-    if (rt_i2c_master_send(device->i2c, device->device_address, RT_NULL, buf, 2) == 2)
+    if (state == RT_NULL)
     {
-        return RT_EOK;
+        return;
     }
-    return RT_ERROR;
+
+    *state = (*state & ~(0xff << shift)) | (register_value << shift);
 }
 
-rt_err_t x9555_port_config(x9555_device_t device, rt_uint8_t port, rt_uint8_t config_register,
-                           rt_uint8_t register_value)
+/****************************************************************************************/
+
+/**
+ * Time base of the driver statistics. It is the DWT cycle counter where the core has one
+ * and the OS tick otherwise, override both functions to use another counter.
+ */
+__attribute__((weak)) rt_uint32_t x9555_timestamp_get(void)
 {
-    rt_err_t result = RT_EOK;
-    RT_ASSERT(device);
+#ifdef X9555_USING_DWT
+    return DWT->CYCCNT;
+#else
+    return rt_tick_get();
+#endif
+}
 
-    result = rt_mutex_take(device->lock, RT_WAITING_FOREVER);
+__attribute__((weak)) rt_uint32_t x9555_timestamp_frequency(void)
+{
+#ifdef X9555_USING_DWT
+    return SystemCoreClock;
+#else
+    return RT_TICK_PER_SECOND;
+#endif
+}
 
-    if (result == RT_EOK)
+static void x9555_timestamp_init(void)
+{
+#ifdef X9555_USING_DWT
+    if (!(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk))
     {
-        if ((port != X9555_PORT_0) && (port != X9555_PORT_1))
-        {
-            LOG_E("The x9555 port don't found. Please try again.");
-            rt_mutex_release(device->lock);
-            result = -RT_ERROR;
-            return result;
-        }
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+#endif
+}
 
-        if ((config_register != X9555_Register_Configuration_Port_0) &&
-            (config_register != X9555_Register_Configuration_Port_1) &&
-            (config_register != X9555_Register_Polarity_Inversion_Port_0) &&
-            (config_register != X9555_Register_Polarity_Inversion_Port_1))
-        {
-            LOG_E("The x9555 config register don't found. Please try again.");
-            rt_mutex_release(device->lock);
-            result = -RT_ERROR;
-            return result;
-        }
+rt_uint32_t x9555_timestamp_to_us(rt_uint32_t timestamp)
+{
+    return (rt_uint32_t)((rt_uint64_t)timestamp * 1000000 / x9555_timestamp_frequency());
+}
 
-        if (port == X9555_PORT_0)
+/****************************************************************************************/
+
+#ifdef PKG_USING_X9555_TRACE
+/* one ring for every device, writers only reserve a slot, so a record being written may read torn */
+static struct x9555_trace_record x9555_trace_ring[PKG_X9555_TRACE_DEPTH];
+static rt_atomic_t x9555_trace_head = 0;
+
+static void x9555_trace_add(rt_uint8_t addr, rt_uint8_t reg, rt_uint8_t len, rt_uint8_t flags)
+{
+    rt_atomic_t index = rt_atomic_add(&x9555_trace_head, 1);
+    struct x9555_trace_record *record = &x9555_trace_ring[index & (PKG_X9555_TRACE_DEPTH - 1)];
+
+    record->timestamp = x9555_timestamp_get();
+    record->addr = addr;
+    record->reg = reg;
+    record->len = len;
+    record->flags = flags;
+}
+
+/* a write followed by a read is one register read, any other write is one register write */
+static void x9555_trace_msgs(struct rt_i2c_msg *msgs, rt_uint32_t num, rt_err_t result)
+{
+    rt_uint8_t flags = (result == RT_EOK) ? 0 : X9555_TRACE_ERROR;
+    rt_uint32_t i;
+
+    for (i = 0; i < num; i++)
+    {
+        if ((i + 1 < num) && (msgs[i + 1].flags & RT_I2C_RD))
         {
-            if (config_register == X9555_Register_Configuration_Port_0)
-            {
-                result = x9555_write_one_byte(device, X9555_Register_Configuration_Port_0, register_value);
-            }
-            else if (config_register == X9555_Register_Polarity_Inversion_Port_0)
-            {
-                result = x9555_write_one_byte(device, X9555_Register_Polarity_Inversion_Port_0, register_value);
-            }
-            else
-            {
-                LOG_E("The x9555 config register is not consistent with the port. Please try again.");
-                result = -RT_ERROR;
-            }
+            x9555_trace_add(msgs[i].addr, msgs[i].buf[0], msgs[i + 1].len, flags | X9555_TRACE_READ);
+            i++;
         }
-        else if (port == X9555_PORT_1)
+        else
         {
-            if (config_register == X9555_Register_Configuration_Port_1)
-            {
-                result = x9555_write_one_byte(device, X9555_Register_Configuration_Port_1, register_value);
-            }
-            else if (config_register == X9555_Register_Polarity_Inversion_Port_1)
-            {
-                result = x9555_write_one_byte(device, X9555_Register_Polarity_Inversion_Port_1, register_value);
-            }
-            else
-            {
-                LOG_E("The x9555 config register is not consistent with the port. Please try again.");
-                result = -RT_ERROR;
-            }
+            x9555_trace_add(msgs[i].addr, msgs[i].buf[0], msgs[i].len - 1, flags);
         }
     }
-    else
+}
+
+/**
+ * This function copies the most recent trace records, oldest first.
+ *
+ * @param records the buffer for the records
+ * @param count the size of the buffer in records
+ *
+ * @return the number of records copied
+ */
+rt_size_t x9555_trace_snapshot(struct x9555_trace_record *records, rt_size_t count)
+{
+    rt_atomic_t head = rt_atomic_load(&x9555_trace_head);
+    rt_size_t len, i;
+
+    RT_ASSERT(records);
+
+    len = ((rt_size_t)head < PKG_X9555_TRACE_DEPTH) ? (rt_size_t)head : PKG_X9555_TRACE_DEPTH;
+    if (len > count)
     {
-        LOG_E("The x9555 could not respond  at this time. Please try again.");
-        result = -RT_ERROR;
+        len = count;
     }
 
-    rt_mutex_release(device->lock);
+    for (i = 0; i < len; i++)
+    {
+        records[i] = x9555_trace_ring[(head - len + i) & (PKG_X9555_TRACE_DEPTH - 1)];
+    }
+
+    return len;
+}
+
+void x9555_trace_clear(void)
+{
+    rt_atomic_store(&x9555_trace_head, 0);
+}
+#endif /* PKG_USING_X9555_TRACE */
+
+/* every transfer the driver puts on the bus goes through here */
+static rt_err_t x9555_i2c_transfer(struct rt_i2c_bus_device *i2c, struct rt_i2c_msg *msgs, rt_uint32_t num)
+{
+    rt_err_t result = (rt_i2c_transfer(i2c, msgs, num) == num) ? RT_EOK : -RT_ERROR;
+
+#ifdef PKG_USING_X9555_TRACE
+    x9555_trace_msgs(msgs, num, result);
+#endif
+
     return result;
 }
 
-rt_err_t x9555_port_mode(x9555_device_t device, rt_uint8_t port, rt_uint8_t port_mode)
+/****************************************************************************************/
+
+/* each device has its own lock, a long critical section on one expander does not hold up the others */
+static rt_err_t x9555_lock_create(x9555_device_t device)
 {
-    rt_err_t result = RT_EOK;
-    RT_ASSERT(device);
+    return rt_mutex_init(&device->lock, "x9555", RT_IPC_FLAG_FIFO);
+}
+
+static void x9555_lock_delete(x9555_device_t device)
+{
+    rt_mutex_detach(&device->lock);
+}
 
-    result = rt_mutex_take(device->lock, RT_WAITING_FOREVER);
+/* every driver path takes the device lock through here */
+static rt_err_t x9555_lock_take(x9555_device_t device)
+{
+#ifdef PKG_USING_X9555_LOCK_STATS
+    rt_uint32_t start, wait;
+    rt_err_t result;
+
+    /* the uncontended case costs one extra try */
+    if (rt_mutex_take(&device->lock, RT_WAITING_NO) == RT_EOK)
+    {
+        device->lock_stats.acquisitions++;
+        return RT_EOK;
+    }
 
+    start = x9555_timestamp_get();
+    result = rt_mutex_take(&device->lock, RT_WAITING_FOREVER);
     if (result == RT_EOK)
     {
-        if ((port != X9555_PORT_0) && (port != X9555_PORT_1))
+        wait = x9555_timestamp_get() - start;
+        device->lock_stats.acquisitions++;
+        device->lock_stats.contended++;
+        device->lock_wait += wait;
+        if (wait > device->lock_worst_wait)
         {
-            LOG_E("The x9555 port don't found. Please try again.");
+            device->lock_worst_wait = wait;
+        }
+    }
+    return result;
+#else
+    return rt_mutex_take(&device->lock, RT_WAITING_FOREVER);
+#endif
+}
 
-            rt_mutex_release(device->lock);
+#ifdef PKG_USING_X9555_LOCK_STATS
+/**
+ * This function gets the device lock statistics, the time every API call
+ * and the worker spent waiting for another holder of the device lock.
+ *
+ * @param device the pointer of device driver structure
+ * @param stats the statistics result
+ * @param reset RT_TRUE to clear the statistics after reading
+ */
+rt_err_t x9555_lock_stats_get(x9555_device_t device, struct x9555_lock_stats *stats, rt_bool_t reset)
+{
+    RT_ASSERT(device);
+    RT_ASSERT(stats);
 
-            result = -RT_ERROR;
-            return result;
-        }
+    rt_mutex_take(&device->lock, RT_WAITING_FOREVER);
 
-        if ((port_mode != X9555_INPUT) && (port_mode != X9555_OUTPUT) && (port_mode != X9555_POLARITY_INVERSION))
-        {
-            LOG_E("The x9555 port mode don't found. Please try again.");
+    *stats = device->lock_stats;
+    stats->wait_us = (rt_uint64_t)device->lock_wait * 1000000 / x9555_timestamp_frequency();
+    stats->worst_wait_us = x9555_timestamp_to_us(device->lock_worst_wait);
+    if (reset)
+    {
+        rt_memset(&device->lock_stats, 0, sizeof(struct x9555_lock_stats));
+        device->lock_wait = 0;
+        device->lock_worst_wait = 0;
+    }
 
-            rt_mutex_release(device->lock);
+    rt_mutex_release(&device->lock);
 
-            result = -RT_ERROR;
-            return result;
-        }
+    return RT_EOK;
+}
+#endif /* PKG_USING_X9555_LOCK_STATS */
 
-        if (port_mode == X9555_INPUT)
-        {
-            rt_uint8_t send_register_value = 0xff;
+/****************************************************************************************/
 
-            if (port == X9555_PORT_0)
-            {
-                result = x9555_write_one_byte(device, X9555_Register_Configuration_Port_0, send_register_value);
-            }
-            else if (port == X9555_PORT_1)
-            {
-                result = x9555_write_one_byte(device, X9555_Register_Configuration_Port_1, send_register_value);
-            }
-        }
-        else if (port_mode == X9555_OUTPUT)
-        {
-            rt_uint8_t send_register_value = 0x00;
+static rt_list_t x9555_bus_list = RT_LIST_OBJECT_INIT(x9555_bus_list);
 
-            if (port == X9555_PORT_0)
-            {
-                result = x9555_write_one_byte(device, X9555_Register_Configuration_Port_0, send_register_value);
-            }
-            else if (port == X9555_PORT_1)
-            {
-                result = x9555_write_one_byte(device, X9555_Register_Configuration_Port_1, send_register_value);
-            }
-        }
-        else if (port_mode == X9555_POLARITY_INVERSION)
-        {
-            rt_uint8_t send_register_value = 0xff;
+#ifdef PKG_USING_X9555_BUS_CPU
+/* the core count, kept private so RT_CPUS_NR is only ever defined by rtconfig.h */
+#ifdef RT_CPUS_NR
+#define X9555_CPUS_NR RT_CPUS_NR
+#else
+#define X9555_CPUS_NR 1
+#endif
 
-            if (port == X9555_PORT_0)
-            {
-                result = x9555_write_one_byte(device, X9555_Register_Configuration_Port_0, send_register_value);
-                result = x9555_write_one_byte(device, X9555_Register_Polarity_Inversion_Port_0, send_register_value);
-            }
-            else if (port == X9555_PORT_1)
-            {
-                result = x9555_write_one_byte(device, X9555_Register_Configuration_Port_1, send_register_value);
-                result = x9555_write_one_byte(device, X9555_Register_Polarity_Inversion_Port_1, send_register_value);
-            }
+struct x9555_bus_cpu
+{
+    char name[RT_NAME_MAX];
+    rt_uint8_t cpu;
+};
+
+static struct x9555_bus_cpu x9555_bus_cpus[PKG_X9555_BUS_CPU_MAX];
+static rt_uint8_t x9555_bus_cpu_next = 0;
+
+/* must be called in a critical section, buses without a preset take the cores in turn */
+static rt_uint8_t x9555_bus_cpu_pick(struct rt_i2c_bus_device *i2c)
+{
+    int i;
+
+    for (i = 0; i < PKG_X9555_BUS_CPU_MAX; i++)
+    {
+        if ((x9555_bus_cpus[i].name[0] != '\0') &&
+            (rt_strncmp(x9555_bus_cpus[i].name, i2c->parent.parent.name, RT_NAME_MAX) == 0))
+        {
+            return x9555_bus_cpus[i].cpu;
         }
     }
-    else
+
+    return x9555_bus_cpu_next++ % X9555_CPUS_NR;
+}
+
+static void x9555_bus_cpu_bind(rt_thread_t thread, rt_uint8_t cpu)
+{
+    if (cpu != X9555_CPU_ANY)
     {
-        LOG_E("The x9555 could not respond  at this time. Please try again.");
-        result = -RT_ERROR;
+        rt_thread_control(thread, RT_THREAD_CTRL_BIND_CPU, (void *)(rt_ubase_t)cpu);
     }
-
-    rt_mutex_release(device->lock);
-    return result;
 }
 
-rt_err_t x9555_port_write(x9555_device_t device, rt_uint8_t port, rt_uint8_t port_value)
+/**
+ * This function sets the core of the service threads of an I2C bus, the worker threads of the
+ * devices on it or its pool worker. It must be called before the first x9555_init() on the bus.
+ * Driver calls are not handed to these threads, they still run in the caller.
+ *
+ * @param i2c_bus_name the I2C bus name
+ * @param cpu the core, X9555_CPU_ANY leaves the threads unbound
+ *
+ * @return the error code, RT_EOK on successfully.
+ */
+rt_err_t x9555_bus_cpu_set(const char *i2c_bus_name, rt_uint8_t cpu)
 {
-    rt_err_t result = RT_EOK;
-    RT_ASSERT(device);
+    struct x9555_bus *bus;
+    rt_err_t result = -RT_EFULL;
+    int i, slot = -1;
 
-    result = rt_mutex_take(device->lock, RT_WAITING_FOREVER);
+    RT_ASSERT(i2c_bus_name);
 
-    if (result == RT_EOK)
+    if ((cpu >= X9555_CPUS_NR) && (cpu != X9555_CPU_ANY))
     {
-        if ((port != X9555_PORT_0) && (port != X9555_PORT_1))
-        {
-            LOG_E("The x9555 port don't found. Please try again.");
-
-            rt_mutex_release(device->lock);
+        return -RT_EINVAL;
+    }
 
-            result = -RT_ERROR;
-            return result;
+    rt_enter_critical();
+    rt_list_for_each_entry(bus, &x9555_bus_list, list)
+    {
+        if (rt_strncmp(bus->i2c->parent.parent.name, i2c_bus_name, RT_NAME_MAX) == 0)
+        {
+            rt_exit_critical();
+            return -RT_EBUSY;
         }
+    }
 
-        if (port == X9555_PORT_0)
+    for (i = 0; i < PKG_X9555_BUS_CPU_MAX; i++)
+    {
+        if (rt_strncmp(x9555_bus_cpus[i].name, i2c_bus_name, RT_NAME_MAX) == 0)
         {
-            result = x9555_write_one_byte(device, X9555_Register_Output_Port_0, port_value);
+            slot = i;
+            break;
         }
-        else if (port == X9555_PORT_1)
+        if ((slot < 0) && (x9555_bus_cpus[i].name[0] == '\0'))
         {
-            result = x9555_write_one_byte(device, X9555_Register_Output_Port_1, port_value);
+            slot = i;
         }
     }
-    else
+    if (slot >= 0)
     {
-        LOG_E("The x9555 could not respond  at this time. Please try again.");
-        result = -RT_ERROR;
+        rt_strncpy(x9555_bus_cpus[slot].name, i2c_bus_name, RT_NAME_MAX);
+        x9555_bus_cpus[slot].cpu = cpu;
+        result = RT_EOK;
     }
+    rt_exit_critical();
 
-    rt_mutex_release(device->lock);
     return result;
 }
 
-rt_uint8_t x9555_port_read(x9555_device_t device, rt_uint8_t port, rt_uint8_t port_mode)
+/**
+ * This function gets the core that serves the I2C bus of a device, callers can bind their own
+ * threads to it to keep the bus traffic on one core.
+ *
+ * @param device the pointer of device driver structure
+ *
+ * @return the core, X9555_CPU_ANY if the service threads are unbound
+ */
+rt_uint8_t x9555_bus_cpu_get(x9555_device_t device)
 {
-    rt_err_t result = RT_EOK;
     RT_ASSERT(device);
 
-    result = rt_mutex_take(device->lock, RT_WAITING_FOREVER);
+    return device->bus->cpu;
+}
+#endif /* PKG_USING_X9555_BUS_CPU */
 
-    rt_uint8_t read_value_buff[2] = {'\0'};
+/* one bus object per I2C bus, shared by every x9555 device on it */
+static struct x9555_bus *x9555_bus_get(struct rt_i2c_bus_device *i2c)
+{
+    struct x9555_bus *bus, *new_bus;
+#ifdef PKG_USING_X9555_BUS_SCHEDULER
+    int prio;
+#endif
 
-    if (result == RT_EOK)
+    new_bus = rt_calloc(1, sizeof(struct x9555_bus));
+    if (new_bus == RT_NULL)
     {
-        if ((port != X9555_PORT_0) && (port != X9555_PORT_1))
-        {
-            LOG_E("The x9555 port don't found. Please try again.");
-
-            rt_mutex_release(device->lock);
+        return RT_NULL;
+    }
 
-            result = -RT_ERROR;
-            return result;
+    rt_enter_critical();
+    rt_list_for_each_entry(bus, &x9555_bus_list, list)
+    {
+        if (bus->i2c == i2c)
+        {
+            bus->ref_count++;
+            rt_exit_critical();
+            rt_free(new_bus);
+            return bus;
         }
+    }
 
-        if ((port_mode != X9555_INPUT) && (port_mode != X9555_OUTPUT) && (port_mode != X9555_POLARITY_INVERSION))
-        {
-            LOG_E("The x9555 port mode don't found. Please try again.");
+    new_bus->i2c = i2c;
+    new_bus->ref_count = 1;
+#ifdef PKG_USING_X9555_BUS_CPU
+    new_bus->cpu = x9555_bus_cpu_pick(i2c);
+#endif
+#ifdef X9555_USING_WORKER_POOL
+    rt_list_init(&new_bus->devices);
+    rt_list_init(&new_bus->run_queue);
+    rt_spin_lock_init(&new_bus->run_lock);
+#endif
+#ifdef PKG_USING_X9555_BUS_SCHEDULER
+    rt_spin_lock_init(&new_bus->spinlock);
+    for (prio = 0; prio < X9555_PRIO_NUM; prio++)
+    {
+        rt_list_init(&new_bus->queue[prio]);
+    }
+#endif
+    rt_list_insert_before(&x9555_bus_list, &new_bus->list);
+    rt_exit_critical();
 
-            rt_mutex_release(device->lock);
+    return new_bus;
+}
 
-            result = -RT_ERROR;
-            return result;
+static void x9555_bus_put(struct x9555_bus *bus)
+{
+    rt_bool_t last;
+
+    rt_enter_critical();
+    last = (--bus->ref_count == 0);
+    if (last)
+    {
+        rt_list_remove(&bus->list);
+    }
+    rt_exit_critical();
+
+    if (last)
+    {
+        rt_free(bus);
+    }
+}
+
+#ifdef PKG_USING_X9555_BUS_SCHEDULER
+#define X9555_BUS_HANDOFF       (-0x5555)
+
+/* the priority moved into the scheduler private data of the thread in 5.1.0 */
+#ifdef RT_VERSION_CHECK
+#if RTTHREAD_VERSION >= RT_VERSION_CHECK(5, 1, 0)
+#define X9555_THREAD_PRIO(thread)   (RT_SCHED_PRIV(thread).current_priority)
+#endif
+#endif
+#ifndef X9555_THREAD_PRIO
+#define X9555_THREAD_PRIO(thread)   ((thread)->current_priority)
+#endif
+
+struct x9555_bus_waiter
+{
+    rt_list_t node;
+    rt_err_t result;
+    rt_uint8_t prio;          // thread priority of the waiter
+    struct rt_completion done;
+};
+
+struct x9555_bus_request
+{
+    rt_list_t node;
+    rt_list_t waiters;
+    struct rt_i2c_msg msgs[3];
+    rt_uint32_t num;
+    rt_uint8_t buf[3];
+    rt_uint8_t prio;
+    rt_uint32_t timestamp;
+};
+
+/* must be called with the spinlock held, the next request always comes from the highest class */
+static struct x9555_bus_request *x9555_bus_next(struct x9555_bus *bus)
+{
+    int prio;
+
+    for (prio = 0; prio < X9555_PRIO_NUM; prio++)
+    {
+        if (!rt_list_isempty(&bus->queue[prio]))
+        {
+            return rt_list_first_entry(&bus->queue[prio], struct x9555_bus_request, node);
         }
+    }
+    return RT_NULL;
+}
 
-        if (port_mode == X9555_INPUT)
+/*
+ * must be called with the spinlock held. A waiter of a higher priority than the combiner lends it its
+ * priority, so no thread of a middle priority can hold up the transfer the waiter is blocked on.
+ */
+static void x9555_bus_boost(struct x9555_bus *bus, rt_uint8_t prio)
+{
+    if ((bus->combiner != RT_NULL) && (prio < X9555_THREAD_PRIO(bus->combiner)))
+    {
+        rt_thread_control(bus->combiner, RT_THREAD_CTRL_CHANGE_PRIORITY, &prio);
+        bus->boost_prio = prio;
+        bus->boosted = RT_TRUE;
+    }
+}
+
+/* must be called with the spinlock held, a priority a mutex has changed since the boost is left alone */
+static void x9555_bus_unboost(struct x9555_bus *bus)
+{
+    if (bus->boosted && (X9555_THREAD_PRIO(bus->combiner) == bus->boost_prio))
+    {
+        rt_thread_control(bus->combiner, RT_THREAD_CTRL_CHANGE_PRIORITY, &bus->combiner_prio);
+    }
+    bus->boosted = RT_FALSE;
+    bus->combiner = RT_NULL;
+}
+
+/*
+ * The first thread to find the bus idle becomes the combiner: it takes the I2C bus lock once and
+ * runs every queued request back to back, then hands the role over after PKG_X9555_BUS_BATCH_MAX.
+ * While it serves, it runs at the priority of the most urgent queued waiter.
+ */
+static void x9555_bus_combine(struct x9555_bus *bus)
+{
+    struct x9555_bus_request *request;
+    struct x9555_bus_waiter *waiter, *next;
+    rt_list_t done_list;
+    rt_uint32_t count = 0;
+    rt_uint32_t latency, start, locked, transfer;
+    rt_uint8_t prio;
+    rt_base_t level;
+    rt_err_t result;
+
+    /* the tick is too coarse for a batch of a few hundred us, the timestamp counter is used instead */
+    start = x9555_timestamp_get();
+    rt_mutex_take(&bus->i2c->lock, RT_WAITING_FOREVER);
+    locked = x9555_timestamp_get();
+
+    level = rt_spin_lock_irqsave(&bus->spinlock);
+    bus->stats.batches++;
+    bus->lock_time += locked - start;
+
+    /* registered only with the I2C bus lock held, so the lock never records a borrowed priority as the original */
+    bus->combiner = rt_thread_self();
+    bus->combiner_prio = X9555_THREAD_PRIO(bus->combiner);
+    for (prio = 0; prio < X9555_PRIO_NUM; prio++)
+    {
+        rt_list_for_each_entry(request, &bus->queue[prio], node)
         {
-            if (port == X9555_PORT_0)
-            {
-                result = x9555_read_one_byte(device, X9555_Register_Input_Port_0, read_value_buff);
-            }
-            else if (port == X9555_PORT_1)
+            rt_list_for_each_entry(waiter, &request->waiters, node)
             {
-                result = x9555_read_one_byte(device, X9555_Register_Input_Port_1, read_value_buff);
+                x9555_bus_boost(bus, waiter->prio);
             }
         }
-        else if (port_mode == X9555_OUTPUT)
+    }
+
+    while ((request = x9555_bus_next(bus)) != RT_NULL)
+    {
+        if (count >= PKG_X9555_BUS_BATCH_MAX)
         {
-            if (port == X9555_PORT_0)
-            {
-                result = x9555_read_one_byte(device, X9555_Register_Output_Port_0, read_value_buff);
-            }
-            else if (port == X9555_PORT_1)
-            {
-                result = x9555_read_one_byte(device, X9555_Register_Output_Port_1, read_value_buff);
-            }
+            bus->busy_time += x9555_timestamp_get() - locked;
+            waiter = rt_list_first_entry(&request->waiters, struct x9555_bus_waiter, node);
+            waiter->result = X9555_BUS_HANDOFF;
+            x9555_bus_unboost(bus);
+            rt_spin_unlock_irqrestore(&bus->spinlock, level);
+            rt_mutex_release(&bus->i2c->lock);
+            rt_completion_done(&waiter->done);
+            return;
         }
-        else if (port_mode == X9555_POLARITY_INVERSION)
+
+        /* once off the queue the request can no longer take merges, and its waiters move to a local list */
+        rt_list_remove(&request->node);
+        rt_list_init(&done_list);
+        if (!rt_list_isempty(&request->waiters))
         {
-            if (port == X9555_PORT_0)
-            {
-                result = x9555_read_one_byte(device, X9555_Register_Polarity_Inversion_Port_0, read_value_buff);
-            }
-            else if (port == X9555_PORT_1)
-            {
-                result = x9555_read_one_byte(device, X9555_Register_Polarity_Inversion_Port_0, read_value_buff);
-            }
+            done_list.next = request->waiters.next;
+            done_list.prev = request->waiters.prev;
+            done_list.next->prev = &done_list;
+            done_list.prev->next = &done_list;
+            rt_list_init(&request->waiters);
+        }
+        rt_spin_unlock_irqrestore(&bus->spinlock, level);
+
+        transfer = x9555_timestamp_get();
+        result = x9555_i2c_transfer(bus->i2c, request->msgs, request->num);
+        count++;
+
+        /* the request belongs to a waiter's stack, take what is needed before waking it */
+        prio = request->prio;
+        latency = x9555_timestamp_get();
+        transfer = latency - transfer;
+        latency -= request->timestamp;
+
+        rt_list_for_each_entry_safe(waiter, next, &done_list, node)
+        {
+            waiter->result = result;
+            rt_completion_done(&waiter->done);
+        }
+
+        level = rt_spin_lock_irqsave(&bus->spinlock);
+        bus->stats.transfers++;
+        bus->stats.completed[prio]++;
+        bus->transfer_time += transfer;
+        if (latency > bus->worst_latency[prio])
+        {
+            bus->worst_latency[prio] = latency;
         }
     }
-    else
+
+    bus->busy = RT_FALSE;
+    bus->busy_time += x9555_timestamp_get() - locked;
+    x9555_bus_unboost(bus);
+    rt_spin_unlock_irqrestore(&bus->spinlock, level);
+
+    rt_mutex_release(&bus->i2c->lock);
+}
+
+static rt_err_t x9555_bus_wait(struct x9555_bus *bus, struct x9555_bus_waiter *waiter, rt_bool_t combine)
+{
+    if (combine)
     {
-        LOG_E("The x9555 could not respond  at this time. Please try again.");
-        result = -RT_ERROR;
+        x9555_bus_combine(bus);
     }
 
-    rt_mutex_release(device->lock);
-
-    if (result != RT_EOK)
+    while (1)
     {
-        rt_memset(read_value_buff, '\0', sizeof(read_value_buff));
+        rt_completion_wait(&waiter->done, RT_WAITING_FOREVER);
+        if (waiter->result != X9555_BUS_HANDOFF)
+        {
+            return waiter->result;
+        }
+        x9555_bus_combine(bus);
     }
+}
 
-    return *read_value_buff;
+/* must be called with the spinlock held, returns RT_TRUE if the caller has to run the combiner */
+static rt_bool_t x9555_bus_enqueue(struct x9555_bus *bus, struct x9555_bus_request *request,
+                                   struct x9555_bus_waiter *waiter)
+{
+    rt_bool_t combine = !bus->busy;
+
+    request->timestamp = x9555_timestamp_get();
+    rt_list_init(&request->waiters);
+    rt_list_insert_before(&request->waiters, &waiter->node);
+    rt_list_insert_before(&bus->queue[request->prio], &request->node);
+    bus->busy = RT_TRUE;
+
+    waiter->prio = X9555_THREAD_PRIO(rt_thread_self());
+    x9555_bus_boost(bus, waiter->prio);
+
+    return combine;
 }
 
-/****************************************************************************************/
-static rt_err_t x9555_pin_port_switch(const rt_uint8_t pin)
+static rt_err_t x9555_bus_transfer(x9555_device_t device, struct rt_i2c_msg *msgs, rt_uint32_t num, rt_uint8_t prio)
 {
-    rt_uint8_t _port = X9555_PORT_NULL;
+    struct x9555_bus *bus = device->bus;
+    struct x9555_bus_request request;
+    struct x9555_bus_waiter waiter;
+    rt_bool_t combine;
+    rt_base_t level;
 
-    switch (pin)
+    RT_ASSERT(num <= 3);
+
+    request.prio = prio;
+    request.num = num;
+    rt_memcpy(request.msgs, msgs, num * sizeof(struct rt_i2c_msg));
+    rt_completion_init(&waiter.done);
+
+    level = rt_spin_lock_irqsave(&bus->spinlock);
+    bus->stats.requests++;
+    combine = x9555_bus_enqueue(bus, &request, &waiter);
+    rt_spin_unlock_irqrestore(&bus->spinlock, level);
+
+    return x9555_bus_wait(bus, &waiter, combine);
+}
+
+/* must be called with device->lock held, it stays held so the steps of a caller never interleave with another thread */
+static rt_err_t x9555_bus_write(x9555_device_t device, rt_uint8_t register_address,
+                                const rt_uint8_t *send_buffer, rt_uint16_t len)
+{
+    struct x9555_bus *bus = device->bus;
+    struct x9555_bus_request request;
+    struct x9555_bus_waiter waiter;
+    rt_bool_t combine;
+    rt_base_t level;
+    rt_uint16_t i;
+    rt_err_t result;
+
+    RT_ASSERT(len <= 2);
+
+    rt_completion_init(&waiter.done);
+
+    /* the device lock keeps a second write of this device off the queue, writes go out in program order */
+    request.prio = X9555_PRIO_NORMAL;
+    request.num = 1;
+    request.buf[0] = register_address;
+    rt_memcpy(&request.buf[1], send_buffer, len);
+    request.msgs[0].addr = device->device_address;
+    request.msgs[0].flags = RT_I2C_WR;
+    request.msgs[0].buf = request.buf;
+    request.msgs[0].len = len + 1;
+
+    level = rt_spin_lock_irqsave(&bus->spinlock);
+    bus->stats.requests++;
+    combine = x9555_bus_enqueue(bus, &request, &waiter);
+    rt_spin_unlock_irqrestore(&bus->spinlock, level);
+
+    result = x9555_bus_wait(bus, &waiter, combine);
+
+    /* like x9555_write_through(), the shadow only follows what the chip acknowledged */
+    if (result == RT_EOK)
     {
-    case X9555_IO_0_0:
-    case X9555_IO_0_1:
-    case X9555_IO_0_2:
-    case X9555_IO_0_3:
-    case X9555_IO_0_4:
-    case X9555_IO_0_5:
-    case X9555_IO_0_6:
-    case X9555_IO_0_7:
+        for (i = 0; i < len; i++)
+        {
+            x9555_shadow_update(device, register_address ^ (i & 0x01), send_buffer[i]);
+        }
+    }
+
+    return result;
+}
+
+/**
+ * This function gets the transaction statistics of the I2C bus a device sits on.
+ * requests - batches is the number of transfers that ran without a bus lock acquisition of their own.
+ * These are counters of the running driver, no transfer is merged or rewritten by the scheduler.
+ *
+ * @param device the pointer of device driver structure
+ * @param stats the statistics result
+ * @param reset RT_TRUE to clear the statistics after reading
+ */
+rt_err_t x9555_bus_stats_get(x9555_device_t device, struct x9555_bus_stats *stats, rt_bool_t reset)
+{
+    rt_uint32_t worst_latency[X9555_PRIO_NUM];
+    rt_uint64_t lock_time, busy_time, transfer_time;
+    struct x9555_bus *bus;
+    rt_base_t level;
+    int prio;
+
+    RT_ASSERT(device);
+    RT_ASSERT(stats);
+
+    bus = device->bus;
+    level = rt_spin_lock_irqsave(&bus->spinlock);
+    *stats = bus->stats;
+    rt_memcpy(worst_latency, bus->worst_latency, sizeof(worst_latency));
+    lock_time = bus->lock_time;
+    busy_time = bus->busy_time;
+    transfer_time = bus->transfer_time;
+    if (reset)
     {
-        _port = X9555_PORT_0;
-        break;
+        rt_memset(&bus->stats, 0, sizeof(struct x9555_bus_stats));
+        rt_memset(bus->worst_latency, 0, sizeof(worst_latency));
+        bus->lock_time = 0;
+        bus->busy_time = 0;
+        bus->transfer_time = 0;
     }
-    case X9555_IO_1_0:
-    case X9555_IO_1_1:
-    case X9555_IO_1_2:
-    case X9555_IO_1_3:
-    case X9555_IO_1_4:
-    case X9555_IO_1_5:
-    case X9555_IO_1_6:
-    case X9555_IO_1_7:
+    rt_spin_unlock_irqrestore(&bus->spinlock, level);
+
+    stats->lock_us = (rt_uint32_t)(lock_time * 1000000 / x9555_timestamp_frequency());
+    stats->busy_us = (rt_uint32_t)(busy_time * 1000000 / x9555_timestamp_frequency());
+    stats->transfer_us = (rt_uint32_t)(transfer_time * 1000000 / x9555_timestamp_frequency());
+
+    for (prio = 0; prio < X9555_PRIO_NUM; prio++)
     {
-        _port = X9555_PORT_1;
-        break;
+        stats->worst_latency_us[prio] = x9555_timestamp_to_us(worst_latency[prio]);
     }
-    default:
+
+    return RT_EOK;
+}
+#endif /* PKG_USING_X9555_BUS_SCHEDULER */
+
+/****************************************************************************************/
+
+#ifdef PKG_USING_X9555_WRITE_BACK
+/* the write-back state exists only while the mode is on */
+struct x9555_write_back
+{
+    rt_bool_t pending;
+    struct rt_timer timer;
+    rt_uint16_t committed[3]; // output, polarity, config as last sent to the chip
+};
+
+static rt_err_t x9555_write_back_flush(x9555_device_t device);
+#endif
+static void x9555_input_update(x9555_device_t device, rt_uint16_t new_value, rt_tick_t tick);
+
+static rt_err_t x9555_read_bytes(x9555_device_t device, rt_uint8_t register_address,
+                                 rt_uint8_t *read_buffer, rt_uint16_t len, rt_uint8_t prio)
+{
+    struct rt_i2c_msg msgs[2];
+
+    msgs[0].addr = device->device_address;
+    msgs[0].flags = RT_I2C_WR;
+    msgs[0].buf = &register_address;
+    msgs[0].len = 1;
+
+    msgs[1].addr = device->device_address;
+    msgs[1].flags = RT_I2C_RD;
+    msgs[1].buf = read_buffer;
+    msgs[1].len = len;
+
+#ifdef PKG_USING_X9555_WRITE_BACK
+    /* whatever is read may depend on outputs or directions still held back */
+    if (device->write_back)
     {
-        _port = X9555_PORT_NULL;
-        break;
+        x9555_write_back_flush(device);
     }
+#endif
+
+#ifdef PKG_USING_X9555_BUS_SCHEDULER
+    return x9555_bus_transfer(device, msgs, 2, prio);
+#else
+    return x9555_i2c_transfer(device->i2c, msgs, 2);
+#endif
+}
+
+static rt_err_t x9555_read_one_byte(x9555_device_t device, rt_uint8_t register_address,
+                                    rt_uint8_t *read_register_value)
+{
+    return x9555_read_bytes(device, register_address, read_register_value, 1, X9555_PRIO_NORMAL);
+}
+
+/* the register pointer toggles inside a register pair, so len bytes go to reg, reg ^ 1, reg, ... */
+static rt_err_t x9555_write_through(x9555_device_t device, rt_uint8_t register_address,
+                                    const rt_uint8_t *send_buffer, rt_uint16_t len)
+{
+#ifdef PKG_USING_X9555_BUS_SCHEDULER
+    return x9555_bus_write(device, register_address, send_buffer, len);
+#else
+    struct rt_i2c_msg msg;
+    rt_uint8_t buf[3];
+    rt_uint16_t i;
+
+    RT_ASSERT(len < sizeof(buf));
+
+    buf[0] = register_address;
+    rt_memcpy(&buf[1], send_buffer, len);
+
+    msg.addr = device->device_address;
+    msg.flags = RT_I2C_WR;
+    msg.buf = buf;
+    msg.len = len + 1;
+
+    if (x9555_i2c_transfer(device->i2c, &msg, 1) == RT_EOK)
+    {
+        for (i = 0; i < len; i++)
+        {
+            x9555_shadow_update(device, register_address ^ (i & 0x01), send_buffer[i]);
+        }
+        return RT_EOK;
     }
-    return _port;
+    return -RT_ERROR;
+#endif
 }
 
-rt_err_t x9555_pin_mode(x9555_device_t device, rt_uint8_t pin, rt_uint8_t pin_mode)
+#ifdef PKG_USING_X9555_WRITE_BACK
+static void x9555_write_back_timeout(void *parameter)
+{
+    x9555_device_t device = (x9555_device_t)parameter;
+
+    x9555_worker_notify(device, X9555_EVENT_FLUSH);
+}
+
+/* must be called with device->lock held, sends only the bytes which differ from the chip */
+static rt_err_t x9555_write_back_flush(x9555_device_t device)
 {
+    const rt_uint8_t registers[3] = {X9555_Register_Output_Port_0, X9555_Register_Polarity_Inversion_Port_0,
+                                     X9555_Register_Configuration_Port_0};
+    rt_uint16_t *committed = device->write_back->committed;
+    rt_uint16_t state, changed;
+    rt_uint8_t buf[2];
     rt_err_t result = RT_EOK;
-    RT_ASSERT(device);
+    int i;
 
-    result = rt_mutex_take(device->lock, RT_WAITING_FOREVER);
+    device->write_back->pending = RT_FALSE;
 
-    if (result == RT_EOK)
+    /* outputs first, so a pin turned into an output drives its new level at once */
+    for (i = 0; i < 3; i++)
     {
-        rt_uint8_t port = X9555_PORT_NULL;
-        rt_uint8_t read_value_buff[2] = {'\0'};
-        rt_uint8_t send_register_value;
+        state = *x9555_shadow_get(device, registers[i]);
+        changed = state ^ committed[i];
+        if (changed == 0)
+        {
+            continue;
+        }
 
-        port = x9555_pin_port_switch(pin);
+        /* claimed before the bus may release the lock, so a concurrent flush does not send it again */
+        committed[i] = state;
+        buf[0] = state & 0xff;
+        buf[1] = state >> 8;
 
-        if (port == X9555_PORT_NULL)
+        if ((changed & 0xff00) == 0)
         {
-            LOG_E("The x9555 pin don't found. Please try again.");
-
-            rt_mutex_release(device->lock);
-            result = -RT_ERROR;
-            return result;
+            result = x9555_write_through(device, registers[i], &buf[0], 1);
+        }
+        else if ((changed & 0x00ff) == 0)
+        {
+            result = x9555_write_through(device, registers[i] | 0x01, &buf[1], 1);
+        }
+        else
+        {
+            result = x9555_write_through(device, registers[i], buf, 2);
         }
 
-        if (pin_mode == X9555_INPUT)
+        if (result != RT_EOK)
         {
-            if (port == X9555_PORT_0)
-            {
-                result = x9555_read_one_byte(device, X9555_Register_Configuration_Port_0, read_value_buff);
+            /* stays dirty, the next flush tries again */
+            committed[i] ^= changed;
+            break;
+        }
+    }
 
-                send_register_value = *read_value_buff | (1 << pin);
+    return result;
+}
 
-                result = x9555_write_one_byte(device, X9555_Register_Configuration_Port_0, send_register_value);
-            }
-            else if (port == X9555_PORT_1)
-            {
-                result = x9555_read_one_byte(device, X9555_Register_Configuration_Port_1, read_value_buff);
+/**
+ * This function switches the write-back mode of a device. Writes then only update the
+ * register state and are sent after the coalescing window, before the next read, or on
+ * x9555_flush(), with only the bytes that differ from the chip.
+ *
+ * @param device the pointer of device driver structure
+ * @param window_us the coalescing window, rounded up to whole ticks, 0 writes through
+ */
+rt_err_t x9555_write_back_set(x9555_device_t device, rt_uint32_t window_us)
+{
+    struct x9555_write_back *write_back;
+    rt_tick_t window;
+    rt_err_t result = RT_EOK;
+    RT_ASSERT(device);
 
-                send_register_value = *read_value_buff | (1 << (pin % 10));
+    x9555_lock_take(device);
+    write_back = device->write_back;
 
-                result = x9555_write_one_byte(device, X9555_Register_Configuration_Port_1, send_register_value);
-            }
+    if (window_us == 0)
+    {
+        if (write_back != RT_NULL)
+        {
+            rt_timer_stop(&write_back->timer);
+            result = x9555_write_back_flush(device);
+            /* a timeout already running only notifies the worker, which finds the mode off */
+            rt_timer_detach(&write_back->timer);
+            device->write_back = RT_NULL;
+            rt_free(write_back);
         }
-        else if (pin_mode == X9555_OUTPUT)
+    }
+    else
+    {
+        if (write_back == RT_NULL)
         {
-            if (port == X9555_PORT_0)
+            write_back = rt_calloc(1, sizeof(struct x9555_write_back));
+            if (write_back == RT_NULL)
             {
-                result = x9555_read_one_byte(device, X9555_Register_Configuration_Port_0, read_value_buff);
-
-                send_register_value = (*read_value_buff) & (~(1 << pin));
-
-                result = x9555_write_one_byte(device, X9555_Register_Configuration_Port_0, send_register_value);
+                rt_mutex_release(&device->lock);
+                return -RT_ENOMEM;
             }
-            else if (port == X9555_PORT_1)
-            {
-                result = x9555_read_one_byte(device, X9555_Register_Configuration_Port_1, read_value_buff);
+            rt_timer_init(&write_back->timer, "x9555w", x9555_write_back_timeout, device, 1, RT_TIMER_FLAG_ONE_SHOT);
+            /* in write-through mode the chip holds what the shadow holds */
+            write_back->committed[0] = device->output_state;
+            write_back->committed[1] = device->polarity_state;
+            write_back->committed[2] = device->config_state;
+            device->write_back = write_back;
+        }
+        window = (rt_tick_t)(((rt_uint64_t)window_us * RT_TICK_PER_SECOND + 999999) / 1000000);
+        rt_timer_control(&write_back->timer, RT_TIMER_CTRL_SET_TIME, &window);
+    }
 
-                send_register_value = (*read_value_buff) & (~(1 << (pin % 10)));
+    rt_mutex_release(&device->lock);
+    return result;
+}
 
-                result = x9555_write_one_byte(device, X9555_Register_Configuration_Port_1, send_register_value);
+/**
+ * This function sends the held back writes of a device now.
+ *
+ * @param device the pointer of device driver structure
+ */
+rt_err_t x9555_flush(x9555_device_t device)
+{
+    rt_err_t result = RT_EOK;
+    RT_ASSERT(device);
+
+    x9555_lock_take(device);
+
+    if (device->write_back)
+    {
+        rt_timer_stop(&device->write_back->timer);
+        result = x9555_write_back_flush(device);
+    }
+
+    rt_mutex_release(&device->lock);
+    return result;
+}
+#endif /* PKG_USING_X9555_WRITE_BACK */
+
+static rt_err_t x9555_write_bytes(x9555_device_t device, rt_uint8_t register_address,
+                                  const rt_uint8_t *send_buffer, rt_uint16_t len)
+{
+#ifdef PKG_USING_X9555_WRITE_BACK
+    rt_uint16_t i;
+
+    if (device->write_back)
+    {
+        for (i = 0; i < len; i++)
+        {
+            x9555_shadow_update(device, register_address ^ (i & 0x01), send_buffer[i]);
+        }
+        if (!device->write_back->pending)
+        {
+            device->write_back->pending = RT_TRUE;
+            rt_timer_start(&device->write_back->timer);
+        }
+        return RT_EOK;
+    }
+#endif
+
+    return x9555_write_through(device, register_address, send_buffer, len);
+}
+
+static rt_err_t x9555_write_one_byte(x9555_device_t device, rt_uint8_t register_address,
+                                     rt_uint8_t send_register_value)
+{
+    return x9555_write_bytes(device, register_address, &send_register_value, 1);
+}
+
+rt_err_t x9555_port_config(x9555_device_t device, rt_uint8_t port, rt_uint8_t config_register,
+                           rt_uint8_t register_value)
+{
+    rt_err_t result = RT_EOK;
+    RT_ASSERT(device);
+
+    result = x9555_lock_take(device);
+
+    if (result == RT_EOK)
+    {
+        if ((port != X9555_PORT_0) && (port != X9555_PORT_1))
+        {
+            LOG_E("The x9555 port don't found. Please try again.");
+            rt_mutex_release(&device->lock);
+            result = -RT_ERROR;
+            return result;
+        }
+
+        if ((config_register != X9555_Register_Configuration_Port_0) &&
+            (config_register != X9555_Register_Configuration_Port_1) &&
+            (config_register != X9555_Register_Polarity_Inversion_Port_0) &&
+            (config_register != X9555_Register_Polarity_Inversion_Port_1))
+        {
+            LOG_E("The x9555 config register don't found. Please try again.");
+            rt_mutex_release(&device->lock);
+            result = -RT_ERROR;
+            return result;
+        }
+
+        if (port == X9555_PORT_0)
+        {
+            if (config_register == X9555_Register_Configuration_Port_0)
+            {
+                result = x9555_write_one_byte(device, X9555_Register_Configuration_Port_0, register_value);
+            }
+            else if (config_register == X9555_Register_Polarity_Inversion_Port_0)
+            {
+                result = x9555_write_one_byte(device, X9555_Register_Polarity_Inversion_Port_0, register_value);
+            }
+            else
+            {
+                LOG_E("The x9555 config register is not consistent with the port. Please try again.");
+                result = -RT_ERROR;
             }
         }
-        else if (pin_mode == X9555_POLARITY_INVERSION)
+        else if (port == X9555_PORT_1)
+        {
+            if (config_register == X9555_Register_Configuration_Port_1)
+            {
+                result = x9555_write_one_byte(device, X9555_Register_Configuration_Port_1, register_value);
+            }
+            else if (config_register == X9555_Register_Polarity_Inversion_Port_1)
+            {
+                result = x9555_write_one_byte(device, X9555_Register_Polarity_Inversion_Port_1, register_value);
+            }
+            else
+            {
+                LOG_E("The x9555 config register is not consistent with the port. Please try again.");
+                result = -RT_ERROR;
+            }
+        }
+    }
+    else
+    {
+        LOG_E("The x9555 could not respond  at this time. Please try again.");
+        result = -RT_ERROR;
+    }
+
+    rt_mutex_release(&device->lock);
+    return result;
+}
+
+rt_err_t x9555_port_mode(x9555_device_t device, rt_uint8_t port, rt_uint8_t port_mode)
+{
+    rt_err_t result = RT_EOK;
+    RT_ASSERT(device);
+
+    result = x9555_lock_take(device);
+
+    if (result == RT_EOK)
+    {
+        if ((port != X9555_PORT_0) && (port != X9555_PORT_1))
+        {
+            LOG_E("The x9555 port don't found. Please try again.");
+
+            rt_mutex_release(&device->lock);
+
+            result = -RT_ERROR;
+            return result;
+        }
+
+        if ((port_mode != X9555_INPUT) && (port_mode != X9555_OUTPUT) && (port_mode != X9555_POLARITY_INVERSION))
+        {
+            LOG_E("The x9555 port mode don't found. Please try again.");
+
+            rt_mutex_release(&device->lock);
+
+            result = -RT_ERROR;
+            return result;
+        }
+
+        if (port_mode == X9555_INPUT)
         {
+            rt_uint8_t send_register_value = 0xff;
+
             if (port == X9555_PORT_0)
             {
-                result = x9555_read_one_byte(device, X9555_Register_Configuration_Port_0, read_value_buff);
+                result = x9555_write_one_byte(device, X9555_Register_Configuration_Port_0, send_register_value);
+            }
+            else if (port == X9555_PORT_1)
+            {
+                result = x9555_write_one_byte(device, X9555_Register_Configuration_Port_1, send_register_value);
+            }
+        }
+        else if (port_mode == X9555_OUTPUT)
+        {
+            rt_uint8_t send_register_value = 0x00;
 
-                send_register_value = *read_value_buff | (1 << pin);
+            if (port == X9555_PORT_0)
+            {
+                result = x9555_write_one_byte(device, X9555_Register_Configuration_Port_0, send_register_value);
+            }
+            else if (port == X9555_PORT_1)
+            {
+                result = x9555_write_one_byte(device, X9555_Register_Configuration_Port_1, send_register_value);
+            }
+        }
+        else if (port_mode == X9555_POLARITY_INVERSION)
+        {
+            rt_uint8_t send_register_value = 0xff;
 
+            if (port == X9555_PORT_0)
+            {
                 result = x9555_write_one_byte(device, X9555_Register_Configuration_Port_0, send_register_value);
+                result = x9555_write_one_byte(device, X9555_Register_Polarity_Inversion_Port_0, send_register_value);
+            }
+            else if (port == X9555_PORT_1)
+            {
+                result = x9555_write_one_byte(device, X9555_Register_Configuration_Port_1, send_register_value);
+                result = x9555_write_one_byte(device, X9555_Register_Polarity_Inversion_Port_1, send_register_value);
+            }
+        }
+    }
+    else
+    {
+        LOG_E("The x9555 could not respond  at this time. Please try again.");
+        result = -RT_ERROR;
+    }
 
-                result = x9555_read_one_byte(device, X9555_Register_Polarity_Inversion_Port_0, read_value_buff);
+    rt_mutex_release(&device->lock);
+    return result;
+}
 
-                send_register_value = *read_value_buff | (1 << pin);
+rt_err_t x9555_port_write(x9555_device_t device, rt_uint8_t port, rt_uint8_t port_value)
+{
+    rt_err_t result = RT_EOK;
+    RT_ASSERT(device);
+
+    result = x9555_lock_take(device);
+
+    if (result == RT_EOK)
+    {
+        if ((port != X9555_PORT_0) && (port != X9555_PORT_1))
+        {
+            LOG_E("The x9555 port don't found. Please try again.");
+
+            rt_mutex_release(&device->lock);
+
+            result = -RT_ERROR;
+            return result;
+        }
+
+        if (port == X9555_PORT_0)
+        {
+            result = x9555_write_one_byte(device, X9555_Register_Output_Port_0, port_value);
+        }
+        else if (port == X9555_PORT_1)
+        {
+            result = x9555_write_one_byte(device, X9555_Register_Output_Port_1, port_value);
+        }
+    }
+    else
+    {
+        LOG_E("The x9555 could not respond  at this time. Please try again.");
+        result = -RT_ERROR;
+    }
+
+    rt_mutex_release(&device->lock);
+    return result;
+}
+
+rt_uint8_t x9555_port_read(x9555_device_t device, rt_uint8_t port, rt_uint8_t port_mode)
+{
+    rt_err_t result = RT_EOK;
+    RT_ASSERT(device);
+
+    result = x9555_lock_take(device);
+
+    rt_uint8_t read_value_buff[2] = {'\0'};
+
+    if (result == RT_EOK)
+    {
+        if ((port != X9555_PORT_0) && (port != X9555_PORT_1))
+        {
+            LOG_E("The x9555 port don't found. Please try again.");
+
+            rt_mutex_release(&device->lock);
+
+            result = -RT_ERROR;
+            return result;
+        }
+
+        if ((port_mode != X9555_INPUT) && (port_mode != X9555_OUTPUT) && (port_mode != X9555_POLARITY_INVERSION))
+        {
+            LOG_E("The x9555 port mode don't found. Please try again.");
+
+            rt_mutex_release(&device->lock);
+
+            result = -RT_ERROR;
+            return result;
+        }
+
+        if (port_mode == X9555_INPUT)
+        {
+            if (port == X9555_PORT_0)
+            {
+                result = x9555_read_one_byte(device, X9555_Register_Input_Port_0, read_value_buff);
+            }
+            else if (port == X9555_PORT_1)
+            {
+                result = x9555_read_one_byte(device, X9555_Register_Input_Port_1, read_value_buff);
+            }
+        }
+        else if (port_mode == X9555_OUTPUT)
+        {
+            if (port == X9555_PORT_0)
+            {
+                result = x9555_read_one_byte(device, X9555_Register_Output_Port_0, read_value_buff);
+            }
+            else if (port == X9555_PORT_1)
+            {
+                result = x9555_read_one_byte(device, X9555_Register_Output_Port_1, read_value_buff);
+            }
+        }
+        else if (port_mode == X9555_POLARITY_INVERSION)
+        {
+            if (port == X9555_PORT_0)
+            {
+                result = x9555_read_one_byte(device, X9555_Register_Polarity_Inversion_Port_0, read_value_buff);
+            }
+            else if (port == X9555_PORT_1)
+            {
+                result = x9555_read_one_byte(device, X9555_Register_Polarity_Inversion_Port_0, read_value_buff);
+            }
+        }
+    }
+    else
+    {
+        LOG_E("The x9555 could not respond  at this time. Please try again.");
+        result = -RT_ERROR;
+    }
+
+    rt_mutex_release(&device->lock);
+
+    if (result != RT_EOK)
+    {
+        rt_memset(read_value_buff, '\0', sizeof(read_value_buff));
+    }
+
+    return *read_value_buff;
+}
+
+/* must be called with device->lock held */
+static rt_err_t x9555_output_write16(x9555_device_t device, rt_uint16_t port_value, rt_uint8_t order)
+{
+    rt_uint16_t changed = port_value ^ device->output_state;
+    rt_uint8_t buf[2];
+
+    if (order == X9555_ORDER_CHANGED_ONLY)
+    {
+        /* a port that keeps its value is not sent, so a Gray-coded step never shows an intermediate state */
+        if (changed == 0)
+        {
+            return RT_EOK;
+        }
+        else if ((changed & 0xff00) == 0)
+        {
+            return x9555_write_one_byte(device, X9555_Register_Output_Port_0, port_value & 0xff);
+        }
+        else if ((changed & 0x00ff) == 0)
+        {
+            return x9555_write_one_byte(device, X9555_Register_Output_Port_1, port_value >> 8);
+        }
+        order = X9555_ORDER_PORT_0_FIRST;
+    }
+
+    /* one auto-increment transaction, the ports change one byte time apart */
+    if (order == X9555_ORDER_PORT_1_FIRST)
+    {
+        buf[0] = port_value >> 8;
+        buf[1] = port_value & 0xff;
+        return x9555_write_bytes(device, X9555_Register_Output_Port_1, buf, 2);
+    }
+
+    buf[0] = port_value & 0xff;
+    buf[1] = port_value >> 8;
+    return x9555_write_bytes(device, X9555_Register_Output_Port_0, buf, 2);
+}
+
+/**
+ * This function writes both output ports in a single I2C transaction.
+ *
+ * @param device the pointer of device driver structure
+ * @param port_value bit 0 ~ 7 is port 0, bit 8 ~ 15 is port 1
+ * @param order X9555_ORDER_PORT_0_FIRST, X9555_ORDER_PORT_1_FIRST or
+ *              X9555_ORDER_CHANGED_ONLY which skips the transfer of an unchanged port
+ */
+rt_err_t x9555_port_write16(x9555_device_t device, rt_uint16_t port_value, rt_uint8_t order)
+{
+    rt_err_t result = RT_EOK;
+    RT_ASSERT(device);
+
+    if (order > X9555_ORDER_CHANGED_ONLY)
+    {
+        LOG_E("The x9555 write order don't found. Please try again.");
+        return -RT_ERROR;
+    }
+
+    result = x9555_lock_take(device);
+
+    if (result == RT_EOK)
+    {
+        result = x9555_output_write16(device, port_value, order);
+    }
+    else
+    {
+        LOG_E("The x9555 could not respond  at this time. Please try again.");
+        result = -RT_ERROR;
+    }
+
+    rt_mutex_release(&device->lock);
+    return result;
+}
+
+/**
+ * This function changes only the masked output pins, in at most one I2C transaction.
+ *
+ * @param device the pointer of device driver structure
+ * @param mask the output pins to change, bit 0 ~ 7 is port 0, bit 8 ~ 15 is port 1
+ * @param value the new level of the masked pins
+ */
+rt_err_t x9555_set_mask16(x9555_device_t device, rt_uint16_t mask, rt_uint16_t value)
+{
+    rt_err_t result = RT_EOK;
+    RT_ASSERT(device);
+
+    result = x9555_lock_take(device);
+
+    if (result == RT_EOK)
+    {
+        result = x9555_output_write16(device, (device->output_state & ~mask) | (value & mask), X9555_ORDER_CHANGED_ONLY);
+    }
+    else
+    {
+        LOG_E("The x9555 could not respond  at this time. Please try again.");
+        result = -RT_ERROR;
+    }
+
+    rt_mutex_release(&device->lock);
+    return result;
+}
+
+/**
+ * This function sets the direction of the masked pins, in at most one I2C transaction.
+ *
+ * @param device the pointer of device driver structure
+ * @param mask the pins to change, bit 0 ~ 7 is port 0, bit 8 ~ 15 is port 1
+ * @param inputs the masked pins to make inputs, the other masked pins become outputs
+ */
+rt_err_t x9555_mode_mask16(x9555_device_t device, rt_uint16_t mask, rt_uint16_t inputs)
+{
+    rt_err_t result = RT_EOK;
+    rt_uint16_t config, changed;
+    rt_uint8_t buf[2];
+    RT_ASSERT(device);
+
+    result = x9555_lock_take(device);
+
+    if (result == RT_EOK)
+    {
+        config = (device->config_state & ~mask) | (inputs & mask);
+        changed = config ^ device->config_state;
+
+        if ((changed & 0xff00) == 0)
+        {
+            result = changed ? x9555_write_one_byte(device, X9555_Register_Configuration_Port_0, config & 0xff) : RT_EOK;
+        }
+        else if ((changed & 0x00ff) == 0)
+        {
+            result = x9555_write_one_byte(device, X9555_Register_Configuration_Port_1, config >> 8);
+        }
+        else
+        {
+            buf[0] = config & 0xff;
+            buf[1] = config >> 8;
+            result = x9555_write_bytes(device, X9555_Register_Configuration_Port_0, buf, 2);
+        }
+    }
+    else
+    {
+        LOG_E("The x9555 could not respond  at this time. Please try again.");
+        result = -RT_ERROR;
+    }
+
+    rt_mutex_release(&device->lock);
+    return result;
+}
+
+/**
+ * This function reads both input ports in one I2C transaction and updates the input snapshot.
+ *
+ * @param device the pointer of device driver structure
+ * @param value the input levels, bit 0 ~ 7 is port 0, bit 8 ~ 15 is port 1
+ */
+rt_err_t x9555_input_read16(x9555_device_t device, rt_uint16_t *value)
+{
+    rt_uint8_t read_value_buff[2];
+    rt_err_t result = RT_EOK;
+    RT_ASSERT(device);
+    RT_ASSERT(value);
+
+    result = x9555_lock_take(device);
+
+    if (result == RT_EOK)
+    {
+        result = x9555_read_bytes(device, X9555_Register_Input_Port_0, read_value_buff, 2, X9555_PRIO_NORMAL);
+        if (result == RT_EOK)
+        {
+            x9555_input_update(device, read_value_buff[0] | (read_value_buff[1] << 8), rt_tick_get());
+            *value = device->input_state;
+        }
+    }
+    else
+    {
+        LOG_E("The x9555 could not respond  at this time. Please try again.");
+        result = -RT_ERROR;
+    }
+
+    rt_mutex_release(&device->lock);
+    return result;
+}
+
+/**
+ * This function plays a sequence of 16-bit output values, e.g. a waveform, as auto-increment streams.
+ * It is split into transactions of PKG_X9555_BUS_CHUNK_SIZE values, other requests on the bus
+ * (interrupt input reads first) are served between them.
+ *
+ * @param device the pointer of device driver structure
+ * @param values the output values, bit 0 ~ 7 is port 0, bit 8 ~ 15 is port 1
+ * @param count the number of values
+ */
+rt_err_t x9555_port_write16_burst(x9555_device_t device, const rt_uint16_t *values, rt_size_t count)
+{
+    rt_uint8_t buf[1 + PKG_X9555_BUS_CHUNK_SIZE * 2];
+    struct rt_i2c_msg msg;
+    rt_size_t chunk, i;
+    rt_err_t result = RT_EOK;
+
+    RT_ASSERT(device);
+    RT_ASSERT(values);
+
+    msg.addr = device->device_address;
+    msg.flags = RT_I2C_WR;
+    msg.buf = buf;
+    buf[0] = X9555_Register_Output_Port_0;
+
+    while ((count > 0) && (result == RT_EOK))
+    {
+        chunk = (count > PKG_X9555_BUS_CHUNK_SIZE) ? PKG_X9555_BUS_CHUNK_SIZE : count;
+        for (i = 0; i < chunk; i++)
+        {
+            buf[1 + i * 2] = values[i] & 0xff;
+            buf[2 + i * 2] = values[i] >> 8;
+        }
+        msg.len = 1 + chunk * 2;
+
+        x9555_lock_take(device);
+#ifdef PKG_USING_X9555_WRITE_BACK
+        if (device->write_back)
+        {
+            x9555_write_back_flush(device);
+        }
+#endif
+#ifdef PKG_USING_X9555_BUS_SCHEDULER
+        result = x9555_bus_transfer(device, &msg, 1, X9555_PRIO_BULK);
+#else
+        result = x9555_i2c_transfer(device->i2c, &msg, 1);
+#endif
+        if (result == RT_EOK)
+        {
+            x9555_shadow_update(device, X9555_Register_Output_Port_0, buf[msg.len - 2]);
+            x9555_shadow_update(device, X9555_Register_Output_Port_1, buf[msg.len - 1]);
+#ifdef PKG_USING_X9555_WRITE_BACK
+            if (device->write_back)
+            {
+                device->write_back->committed[0] = device->output_state;
+            }
+#endif
+        }
+        rt_mutex_release(&device->lock);
+
+        values += chunk;
+        count -= chunk;
+    }
+
+    return result;
+}
+
+/****************************************************************************************/
+static rt_err_t x9555_pin_port_switch(const rt_uint8_t pin)
+{
+    rt_uint8_t _port = X9555_PORT_NULL;
+
+    switch (pin)
+    {
+    case X9555_IO_0_0:
+    case X9555_IO_0_1:
+    case X9555_IO_0_2:
+    case X9555_IO_0_3:
+    case X9555_IO_0_4:
+    case X9555_IO_0_5:
+    case X9555_IO_0_6:
+    case X9555_IO_0_7:
+    {
+        _port = X9555_PORT_0;
+        break;
+    }
+    case X9555_IO_1_0:
+    case X9555_IO_1_1:
+    case X9555_IO_1_2:
+    case X9555_IO_1_3:
+    case X9555_IO_1_4:
+    case X9555_IO_1_5:
+    case X9555_IO_1_6:
+    case X9555_IO_1_7:
+    {
+        _port = X9555_PORT_1;
+        break;
+    }
+    default:
+    {
+        _port = X9555_PORT_NULL;
+        break;
+    }
+    }
+    return _port;
+}
+
+/* pin number -> bit of the 16-bit port pair value, -1 if the pin is invalid */
+rt_inline rt_int8_t x9555_pin_to_bit(const rt_uint8_t pin)
+{
+    rt_uint8_t port = x9555_pin_port_switch(pin);
+
+    if (port == X9555_PORT_0)
+    {
+        return pin;
+    }
+    else if (port == X9555_PORT_1)
+    {
+        return (pin % 10) + 8;
+    }
+    return -1;
+}
+
+rt_err_t x9555_pin_mode(x9555_device_t device, rt_uint8_t pin, rt_uint8_t pin_mode)
+{
+    rt_err_t result = RT_EOK;
+    RT_ASSERT(device);
+
+    result = x9555_lock_take(device);
+
+    if (result == RT_EOK)
+    {
+        rt_uint8_t port = X9555_PORT_NULL;
+        rt_uint8_t read_value_buff[2] = {'\0'};
+        rt_uint8_t send_register_value;
+
+        port = x9555_pin_port_switch(pin);
+
+        if (port == X9555_PORT_NULL)
+        {
+            LOG_E("The x9555 pin don't found. Please try again.");
+
+            rt_mutex_release(&device->lock);
+            result = -RT_ERROR;
+            return result;
+        }
+
+        if (pin_mode == X9555_INPUT)
+        {
+            if (port == X9555_PORT_0)
+            {
+                *read_value_buff = device->config_state & 0xff;
+
+                send_register_value = *read_value_buff | (1 << pin);
+
+                result = x9555_write_one_byte(device, X9555_Register_Configuration_Port_0, send_register_value);
+            }
+            else if (port == X9555_PORT_1)
+            {
+                *read_value_buff = device->config_state >> 8;
+
+                send_register_value = *read_value_buff | (1 << (pin % 10));
+
+                result = x9555_write_one_byte(device, X9555_Register_Configuration_Port_1, send_register_value);
+            }
+        }
+        else if (pin_mode == X9555_OUTPUT)
+        {
+            if (port == X9555_PORT_0)
+            {
+                *read_value_buff = device->config_state & 0xff;
+
+                send_register_value = (*read_value_buff) & (~(1 << pin));
+
+                result = x9555_write_one_byte(device, X9555_Register_Configuration_Port_0, send_register_value);
+            }
+            else if (port == X9555_PORT_1)
+            {
+                *read_value_buff = device->config_state >> 8;
+
+                send_register_value = (*read_value_buff) & (~(1 << (pin % 10)));
+
+                result = x9555_write_one_byte(device, X9555_Register_Configuration_Port_1, send_register_value);
+            }
+        }
+        else if (pin_mode == X9555_POLARITY_INVERSION)
+        {
+            if (port == X9555_PORT_0)
+            {
+                *read_value_buff = device->config_state & 0xff;
+
+                send_register_value = *read_value_buff | (1 << pin);
+
+                result = x9555_write_one_byte(device, X9555_Register_Configuration_Port_0, send_register_value);
+
+                *read_value_buff = device->polarity_state & 0xff;
+
+                send_register_value = *read_value_buff | (1 << pin);
+
+                result = x9555_write_one_byte(device, X9555_Register_Polarity_Inversion_Port_0, send_register_value);
+            }
+            else if (port == X9555_PORT_1)
+            {
+                *read_value_buff = device->config_state >> 8;
+
+                send_register_value = *read_value_buff | (1 << (pin % 10));
+
+                result = x9555_write_one_byte(device, X9555_Register_Configuration_Port_1, send_register_value);
+
+                *read_value_buff = device->polarity_state >> 8;
+
+                send_register_value = *read_value_buff | (1 << (pin % 10));
+
+                result = x9555_write_one_byte(device, X9555_Register_Polarity_Inversion_Port_1, send_register_value);
+            }
+        }
+    }
+    else
+    {
+        LOG_E("The x9555 could not respond  at this time. Please try again.");
+        result = -RT_ERROR;
+    }
+
+    rt_mutex_release(&device->lock);
+    return result;
+}
+
+rt_err_t x9555_pin_write(x9555_device_t device, rt_uint8_t pin, rt_uint8_t pin_state)
+{
+    rt_err_t result = RT_EOK;
+    RT_ASSERT(device);
+
+    result = x9555_lock_take(device);
+
+    if (result == RT_EOK)
+    {
+        rt_uint8_t port = X9555_PORT_NULL;
+        rt_uint8_t read_value_buff[2] = {'\0'};
+        rt_uint8_t send_pin_state;
+
+        port = x9555_pin_port_switch(pin);
+
+        if (port == X9555_PORT_NULL)
+        {
+            LOG_E("The x9555 pin don't found. Please try again.");
+
+            rt_mutex_release(&device->lock);
+            result = -RT_ERROR;
+            return result;
+        }
+
+        if ((pin_state != X9555_PIN_HIGH) && (pin_state != X9555_PIN_LOW))
+        {
+            LOG_E("The x9555 pin state don't found. Please try again.");
+
+            rt_mutex_release(&device->lock);
+            result = -RT_ERROR;
+            return result;
+        }
+
+        if (port == X9555_PORT_0)
+        {
+            *read_value_buff = device->output_state & 0xff;
+
+            if (pin_state == X9555_PIN_HIGH)
+            {
+                send_pin_state = *read_value_buff | (1 << pin);
+            }
+            else if (pin_state == X9555_PIN_LOW)
+            {
+                send_pin_state = (*read_value_buff) & (~(1 << pin));
+            }
+            result = x9555_write_one_byte(device, X9555_Register_Output_Port_0, send_pin_state);
+        }
+        else if (port == X9555_PORT_1)
+        {
+            *read_value_buff = device->output_state >> 8;
+
+            if (pin_state == X9555_PIN_HIGH)
+            {
+                send_pin_state = *read_value_buff | (1 << (pin % 10));
+            }
+            else if (pin_state == X9555_PIN_LOW)
+            {
+                send_pin_state = (*read_value_buff) & (~(1 << (pin % 10)));
+            }
+            result = x9555_write_one_byte(device, X9555_Register_Output_Port_1, send_pin_state);
+        }
+    }
+    else
+    {
+        LOG_E("The x9555 could not respond  at this time. Please try again.");
+        result = -RT_ERROR;
+    }
+
+    rt_mutex_release(&device->lock);
+    return result;
+}
+
+rt_bool_t x9555_pin_read(x9555_device_t device, rt_uint8_t pin, rt_uint8_t pin_mode)
+{
+    rt_err_t result = RT_EOK;
+    RT_ASSERT(device);
+
+    rt_bool_t read_state = X9555_PIN_NULL;
+    rt_uint8_t port = X9555_PORT_NULL;
+    rt_uint8_t read_value_buff[2] = {'\0'};
+
+    result = x9555_lock_take(device);
+
+    if (result == RT_EOK)
+    {
+        port = x9555_pin_port_switch(pin);
+
+        if (port == X9555_PORT_NULL)
+        {
+            LOG_E("The x9555 pin don't found. Please try again.");
+
+            rt_mutex_release(&device->lock);
+            result = -RT_ERROR;
+            return result;
+        }
+
+        if ((pin_mode != X9555_PIN_HIGH) && (pin_mode != X9555_PIN_LOW))
+        {
+            LOG_E("The x9555 pin state don't found. Please try again.");
+
+            rt_mutex_release(&device->lock);
+            result = -RT_ERROR;
+            return result;
+        }
+
+        if (pin_mode == X9555_INPUT)
+        {
+            if (port == X9555_PORT_0)
+            {
+                result = x9555_read_one_byte(device, X9555_Register_Input_Port_0, read_value_buff);
+            }
+            else if (port == X9555_PORT_1)
+            {
+                result = x9555_read_one_byte(device, X9555_Register_Input_Port_1, read_value_buff);
+            }
+        }
+        else if (pin_mode == X9555_OUTPUT)
+        {
+            if (port == X9555_PORT_0)
+            {
+                result = x9555_read_one_byte(device, X9555_Register_Output_Port_0, read_value_buff);
+            }
+            else if (port == X9555_PORT_1)
+            {
+                result = x9555_read_one_byte(device, X9555_Register_Output_Port_1, read_value_buff);
+            }
+        }
+        else if (pin_mode == X9555_POLARITY_INVERSION)
+        {
+            if (port == X9555_PORT_0)
+            {
+                result = x9555_read_one_byte(device, X9555_Register_Polarity_Inversion_Port_0, read_value_buff);
+            }
+            else if (port == X9555_PORT_1)
+            {
+                result = x9555_read_one_byte(device, X9555_Register_Polarity_Inversion_Port_0, read_value_buff);
+            }
+        }
+
+        if (result == RT_EOK)
+        {
+            if (port == X9555_PORT_0)
+            {
+                read_state = (*read_value_buff & (1 << pin)) > 0 ? X9555_PIN_HIGH : X9555_PIN_LOW;
+            }
+            else if (port == X9555_PORT_1)
+            {
+                read_state = (*read_value_buff & (1 << (pin % 10))) > 0 ? X9555_PIN_HIGH : X9555_PIN_LOW;
+            }
+        }
+    }
+    else
+    {
+        LOG_E("The x9555 could not respond  at this time. Please try again.");
+        result = -RT_ERROR;
+    }
+
+    rt_mutex_release(&device->lock);
+    return read_state;
+}
+
+/****************************************************************************************/
+
+/**
+ * Called from the x9555 worker thread after an input interrupt has been serviced,
+ * the input snapshot is already up to date. Override it in the other file.
+ *
+ * @param args the x9555 device which raised the interrupt
+ */
+__attribute__((weak)) void call_input_interrupt(void *args)
+{
+    rt_kprintf("Complete your own interrupt service program in the other file.\n");
+}
+
+#ifdef PKG_USING_X9555_EVENT_RING
+static void x9555_event_ring_push(x9555_device_t device, rt_tick_t tick, rt_uint16_t old_value, rt_uint16_t new_value)
+{
+    struct x9555_event_ring *ring = &device->ring;
+    rt_ubase_t head = (rt_ubase_t)rt_atomic_load(&ring->head);
+    rt_ubase_t tail = (rt_ubase_t)rt_atomic_load(&ring->tail);
+    struct x9555_input_event *event;
+
+    if (head - tail >= PKG_X9555_EVENT_RING_DEPTH)
+    {
+        rt_atomic_add(&ring->dropped, 1);
+        return;
+    }
+
+    event = &ring->buffer[head & (PKG_X9555_EVENT_RING_DEPTH - 1)];
+    event->tick = tick;
+    event->old_value = old_value;
+    event->new_value = new_value;
+
+    /* publish the slot only after it is filled */
+    rt_atomic_store(&ring->head, (rt_atomic_t)(head + 1));
+    rt_completion_done(&ring->ready);
+}
+
+static rt_size_t x9555_event_ring_pop(x9555_device_t device, struct x9555_input_event *events, rt_size_t count)
+{
+    struct x9555_event_ring *ring = &device->ring;
+    rt_ubase_t tail = (rt_ubase_t)rt_atomic_load(&ring->tail);
+    rt_ubase_t head = (rt_ubase_t)rt_atomic_load(&ring->head);
+    rt_size_t len = head - tail;
+    rt_size_t i;
+
+    if (len > count)
+    {
+        len = count;
+    }
+
+    for (i = 0; i < len; i++)
+    {
+        events[i] = ring->buffer[(tail + i) & (PKG_X9555_EVENT_RING_DEPTH - 1)];
+    }
+
+    rt_atomic_store(&ring->tail, (rt_atomic_t)(tail + len));
+    return len;
+}
+
+/**
+ * This function drains input change events recorded by the interrupt or poll bottom half.
+ * Only one consumer thread per device is allowed.
+ *
+ * @param device the pointer of device driver structure
+ * @param events the buffer to store events
+ * @param count the max number of events to read
+ * @param timeout the time to wait for the first event, RT_WAITING_NO returns at once
+ *
+ * @return the number of events read, 0 on timeout
+ */
+rt_size_t x9555_event_read(x9555_device_t device, struct x9555_input_event *events, rt_size_t count, rt_int32_t timeout)
+{
+    rt_size_t len;
+    rt_tick_t start = rt_tick_get();
+    rt_int32_t remain = timeout;
+
+    RT_ASSERT(device);
+    RT_ASSERT(events);
+
+    while (1)
+    {
+        len = x9555_event_ring_pop(device, events, count);
+        if ((len > 0) || (count == 0) || (timeout == RT_WAITING_NO))
+        {
+            return len;
+        }
+
+        if (timeout != RT_WAITING_FOREVER)
+        {
+            remain = timeout - (rt_int32_t)(rt_tick_get() - start);
+            if (remain <= 0)
+            {
+                return 0;
+            }
+        }
+
+        if (rt_completion_wait(&device->ring.ready, remain) != RT_EOK)
+        {
+            return 0;
+        }
+    }
+}
+
+/**
+ * This function gets the number of events dropped because the ring was full.
+ *
+ * @param device the pointer of device driver structure
+ */
+rt_uint32_t x9555_event_dropped(x9555_device_t device)
+{
+    RT_ASSERT(device);
+
+    return (rt_uint32_t)rt_atomic_load(&device->ring.dropped);
+}
+#endif /* PKG_USING_X9555_EVENT_RING */
+
+#ifdef PKG_USING_X9555_EDGE_COUNTER
+/* must be called with device->lock held */
+static void x9555_edge_window_update(x9555_device_t device, rt_tick_t now)
+{
+    struct x9555_edge_counter *edge = device->edge;
+    rt_tick_t elapsed = now - edge->window_start;
+    rt_uint16_t both_mask = edge->rising_mask & edge->falling_mask;
+    rt_uint64_t edges;
+    int bit;
+
+    if (elapsed < rt_tick_from_millisecond(PKG_X9555_EDGE_WINDOW_MS))
+    {
+        return;
+    }
+
+    for (bit = 0; bit < 16; bit++)
+    {
+        /* mHz, a pin counting both edges sees two edges per period */
+        edges = (rt_uint64_t)edge->window_edges[bit] * 1000 * RT_TICK_PER_SECOND;
+        if (both_mask & (1 << bit))
+        {
+            edges /= 2;
+        }
+        edge->frequency[bit] = (rt_uint32_t)(edges / elapsed);
+        edge->window_edges[bit] = 0;
+    }
+    edge->window_start = now;
+}
+
+/* must be called with device->lock held */
+static void x9555_edge_count(x9555_device_t device, rt_uint16_t old_value, rt_uint16_t new_value)
+{
+    struct x9555_edge_counter *edge = device->edge;
+    rt_uint16_t changed = old_value ^ new_value;
+    rt_uint16_t counted;
+    int bit;
+
+    if (edge == RT_NULL)
+    {
+        return;
+    }
+
+    counted = (changed & new_value & edge->rising_mask) | (changed & old_value & edge->falling_mask);
+    x9555_edge_window_update(device, rt_tick_get());
+
+    for (bit = 0; counted != 0; bit++, counted >>= 1)
+    {
+        if (counted & 1)
+        {
+            rt_atomic_add(&edge->count[bit], 1);
+            edge->window_edges[bit]++;
+        }
+    }
+}
+
+/**
+ * This function selects which edges of an input pin are counted by the interrupt or poll bottom half.
+ * Edges shorter than the interrupt service time can not be seen by the driver.
+ *
+ * @param device the pointer of device driver structure
+ * @param pin the x9555 pin
+ * @param edge X9555_EDGE_NONE, X9555_EDGE_RISING, X9555_EDGE_FALLING or X9555_EDGE_BOTH
+ */
+rt_err_t x9555_edge_counter_config(x9555_device_t device, rt_uint8_t pin, rt_uint8_t edge)
+{
+    struct x9555_edge_counter *counter;
+    rt_int8_t bit;
+    RT_ASSERT(device);
+
+    bit = x9555_pin_to_bit(pin);
+    if ((bit < 0) || (edge > X9555_EDGE_BOTH))
+    {
+        LOG_E("The x9555 pin or edge don't found. Please try again.");
+        return -RT_ERROR;
+    }
+
+    x9555_lock_take(device);
+
+    /* the counters of a device are allocated when the first pin is configured */
+    counter = device->edge;
+    if (counter == RT_NULL)
+    {
+        counter = rt_calloc(1, sizeof(struct x9555_edge_counter));
+        if (counter == RT_NULL)
+        {
+            rt_mutex_release(&device->lock);
+            LOG_E("Can't allocate memory for x9555 edge counter. Please try again.");
+            return -RT_ENOMEM;
+        }
+        counter->window_start = rt_tick_get();
+        device->edge = counter;
+    }
+
+    counter->rising_mask &= ~(1 << bit);
+    counter->falling_mask &= ~(1 << bit);
+    if (edge & X9555_EDGE_RISING)
+    {
+        counter->rising_mask |= (1 << bit);
+    }
+    if (edge & X9555_EDGE_FALLING)
+    {
+        counter->falling_mask |= (1 << bit);
+    }
+    rt_atomic_store(&counter->count[bit], 0);
+    counter->window_edges[bit] = 0;
+    counter->frequency[bit] = 0;
+
+    rt_mutex_release(&device->lock);
+    return RT_EOK;
+}
+
+/**
+ * This function reads the edge counter of a pin without touching the bus.
+ *
+ * @param device the pointer of device driver structure
+ * @param pin the x9555 pin
+ * @param reset RT_TRUE to clear the counter in the same atomic operation
+ *
+ * @return the number of edges counted
+ */
+rt_uint32_t x9555_edge_counter_read(x9555_device_t device, rt_uint8_t pin, rt_bool_t reset)
+{
+    rt_int8_t bit;
+    RT_ASSERT(device);
+
+    bit = x9555_pin_to_bit(pin);
+    if (bit < 0)
+    {
+        LOG_E("The x9555 pin don't found. Please try again.");
+        return 0;
+    }
+
+    if (device->edge == RT_NULL)
+    {
+        return 0;
+    }
+    if (reset)
+    {
+        return (rt_uint32_t)rt_atomic_exchange(&device->edge->count[bit], 0);
+    }
+    return (rt_uint32_t)rt_atomic_load(&device->edge->count[bit]);
+}
+
+/**
+ * This function gets the input frequency of a pin, estimated over the last
+ * PKG_X9555_EDGE_WINDOW_MS window.
+ *
+ * @param device the pointer of device driver structure
+ * @param pin the x9555 pin
+ *
+ * @return the frequency in mHz
+ */
+rt_uint32_t x9555_edge_frequency_get(x9555_device_t device, rt_uint8_t pin)
+{
+    rt_int8_t bit;
+    rt_uint32_t frequency;
+    RT_ASSERT(device);
+
+    bit = x9555_pin_to_bit(pin);
+    if (bit < 0)
+    {
+        LOG_E("The x9555 pin don't found. Please try again.");
+        return 0;
+    }
+
+    x9555_lock_take(device);
+    frequency = 0;
+    if (device->edge != RT_NULL)
+    {
+        /* close the window here too, so a stopped signal decays to 0 */
+        x9555_edge_window_update(device, rt_tick_get());
+        frequency = device->edge->frequency[bit];
+    }
+    rt_mutex_release(&device->lock);
+
+    return frequency;
+}
+#endif /* PKG_USING_X9555_EDGE_COUNTER */
+
+#ifdef PKG_USING_X9555_PIN_WAIT
+struct x9555_pin_waiter
+{
+    rt_list_t node;
+    rt_uint16_t pin_mask;
+    rt_uint16_t level_mask;
+    rt_bool_t any;
+    struct rt_completion done;
+};
+
+rt_inline rt_bool_t x9555_pin_condition(rt_uint16_t value, rt_uint16_t pin_mask, rt_uint16_t level_mask, rt_bool_t any)
+{
+    rt_uint16_t matched = ~(value ^ level_mask) & pin_mask;
+
+    return any ? (matched != 0) : (matched == pin_mask);
+}
+
+/* must be called with device->lock held, wakes only the waiters whose condition holds now */
+static void x9555_pin_wait_wakeup(x9555_device_t device)
+{
+    struct x9555_pin_waiter *waiter, *next;
+
+    rt_list_for_each_entry_safe(waiter, next, &device->pin_waiters, node)
+    {
+        if (x9555_pin_condition(device->input_state, waiter->pin_mask, waiter->level_mask, waiter->any))
+        {
+            rt_list_remove(&waiter->node);
+            rt_list_init(&waiter->node);
+            rt_completion_done(&waiter->done);
+        }
+    }
+}
+
+static rt_err_t x9555_pin_wait_condition(x9555_device_t device, rt_uint16_t pin_mask, rt_uint16_t level_mask,
+                                         rt_bool_t any, rt_int32_t timeout)
+{
+    struct x9555_pin_waiter waiter;
+    rt_err_t result;
+
+    RT_ASSERT(device);
+
+    x9555_lock_take(device);
+
+    /* checked and queued under the lock, so a change in between can not be missed */
+    if ((pin_mask == 0) || x9555_pin_condition(device->input_state, pin_mask, level_mask, any))
+    {
+        rt_mutex_release(&device->lock);
+        return RT_EOK;
+    }
+    if (timeout == RT_WAITING_NO)
+    {
+        rt_mutex_release(&device->lock);
+        return -RT_ETIMEOUT;
+    }
+
+    waiter.pin_mask = pin_mask;
+    waiter.level_mask = level_mask;
+    waiter.any = any;
+    rt_completion_init(&waiter.done);
+    rt_list_insert_before(&device->pin_waiters, &waiter.node);
+
+    rt_mutex_release(&device->lock);
+
+    result = rt_completion_wait(&waiter.done, timeout);
+
+    x9555_lock_take(device);
+    if (!rt_list_isempty(&waiter.node))
+    {
+        rt_list_remove(&waiter.node);
+        result = -RT_ETIMEOUT;
+    }
+    else
+    {
+        /* woken by the input path, possibly just as the wait timed out */
+        result = RT_EOK;
+    }
+    rt_mutex_release(&device->lock);
+
+    return result;
+}
+
+/**
+ * This function blocks until every pin in pin_mask is at the level given by level_mask.
+ * It waits on the input snapshot kept by the interrupt or poll path, without bus traffic,
+ * so the device needs an interrupt pin or a poll period.
+ *
+ * @param device the pointer of device driver structure
+ * @param pin_mask the pins to watch, bit 0 ~ 7 port 0, bit 8 ~ 15 port 1
+ * @param level_mask the expected levels of the watched pins
+ * @param timeout the timeout in ticks
+ */
+rt_err_t x9555_pin_wait(x9555_device_t device, rt_uint16_t pin_mask, rt_uint16_t level_mask, rt_int32_t timeout)
+{
+    return x9555_pin_wait_condition(device, pin_mask, level_mask, RT_FALSE, timeout);
+}
+
+/**
+ * This function blocks until any pin in pin_mask is at the level given by level_mask.
+ *
+ * @param device the pointer of device driver structure
+ * @param pin_mask the pins to watch, bit 0 ~ 7 port 0, bit 8 ~ 15 port 1
+ * @param level_mask the expected levels of the watched pins
+ * @param timeout the timeout in ticks
+ */
+rt_err_t x9555_pin_wait_any(x9555_device_t device, rt_uint16_t pin_mask, rt_uint16_t level_mask, rt_int32_t timeout)
+{
+    return x9555_pin_wait_condition(device, pin_mask, level_mask, RT_TRUE, timeout);
+}
+#endif /* PKG_USING_X9555_PIN_WAIT */
+
+#ifdef PKG_USING_X9555_PIN_OPS
+/*
+ * The "pin" device has one rt_pin_ops provider, its ops are wrapped: pins from PKG_X9555_PIN_BASE on
+ * go to the x9555 devices, 16 per device in attach order, everything below goes to the MCU driver.
+ */
+struct x9555_pin_slot
+{
+    x9555_device_t device;
+    rt_base_t base;               // rt pin number of bit 0
+    rt_uint16_t irq_enabled;
+    rt_uint16_t irq_fire;         // handlers due, run by the worker without the device lock
+    struct rt_pin_irq_hdr irq[16];
+};
+
+#define X9555_BIT_TO_PIN(bit)   (((bit) < 8) ? (bit) : ((bit) + 2))
+
+static struct rt_device_pin *x9555_pin_device = RT_NULL;
+static const struct rt_pin_ops *x9555_pin_native = RT_NULL;
+static struct rt_pin_ops x9555_pin_ops;
+static struct x9555_pin_slot *x9555_pin_slots[PKG_X9555_PIN_DEVICES_MAX];
+
+static struct x9555_pin_slot *x9555_pin_slot_get(rt_base_t pin, rt_uint8_t *bit)
+{
+    rt_base_t index = pin - PKG_X9555_PIN_BASE;
+
+    if ((index < 0) || (index >= PKG_X9555_PIN_DEVICES_MAX * 16))
+    {
+        return RT_NULL;
+    }
+
+    *bit = index % 16;
+    return x9555_pin_slots[index / 16];
+}
+
+static void x9555_pin_ops_mode(struct rt_device *parent, rt_base_t pin, rt_uint8_t mode)
+{
+    struct x9555_pin_slot *slot;
+    rt_uint8_t bit;
+
+    if (pin < PKG_X9555_PIN_BASE)
+    {
+        x9555_pin_native->pin_mode(parent, pin, mode);
+        return;
+    }
+
+    slot = x9555_pin_slot_get(pin, &bit);
+    if (slot == RT_NULL)
+    {
+        return;
+    }
+
+    /* every 9555 input has a fixed 100 kohm pull-up, so a pull-up input is a plain input, but nothing pulls down */
+    if (mode == PIN_MODE_INPUT_PULLDOWN)
+    {
+        LOG_E("The x9555 pin %d don't support pull-down mode. Please try again.", pin);
+        return;
+    }
+
+    x9555_pin_mode(slot->device, X9555_BIT_TO_PIN(bit),
+                   ((mode == PIN_MODE_OUTPUT) || (mode == PIN_MODE_OUTPUT_OD)) ? X9555_OUTPUT : X9555_INPUT);
+}
+
+static void x9555_pin_ops_write(struct rt_device *parent, rt_base_t pin, rt_uint8_t value)
+{
+    struct x9555_pin_slot *slot;
+    rt_uint8_t bit;
+
+    if (pin < PKG_X9555_PIN_BASE)
+    {
+        x9555_pin_native->pin_write(parent, pin, value);
+        return;
+    }
+
+    slot = x9555_pin_slot_get(pin, &bit);
+    if (slot != RT_NULL)
+    {
+        x9555_pin_write(slot->device, X9555_BIT_TO_PIN(bit), value ? X9555_PIN_HIGH : X9555_PIN_LOW);
+    }
+}
+
+static rt_ssize_t x9555_pin_ops_read(struct rt_device *parent, rt_base_t pin)
+{
+    struct x9555_pin_slot *slot;
+    x9555_device_t device;
+    rt_uint8_t bit;
+    rt_bool_t state;
+
+    if (pin < PKG_X9555_PIN_BASE)
+    {
+        return x9555_pin_native->pin_read(parent, pin);
+    }
+
+    slot = x9555_pin_slot_get(pin, &bit);
+    if (slot == RT_NULL)
+    {
+        return -RT_EINVAL;
+    }
+    device = slot->device;
+
+    /* an output reads back the level it drives */
+    if (!(device->config_state & (1 << bit)))
+    {
+        return (device->output_state >> bit) & 0x01;
+    }
+
+    /* the snapshot is kept up to date by the interrupt or poll path, without either the bus is read */
+    if (device->input_valid && ((device->device_interrupt_pin > -1) || (device->poll_period != RT_WAITING_FOREVER)))
+    {
+        return (device->input_state >> bit) & 0x01;
+    }
+
+    state = x9555_pin_read(device, X9555_BIT_TO_PIN(bit), X9555_INPUT);
+    return ((state == X9555_PIN_HIGH) || (state == X9555_PIN_LOW)) ? state : -RT_EIO;
+}
+
+static rt_err_t x9555_pin_ops_attach_irq(struct rt_device *parent, rt_base_t pin, rt_uint8_t mode,
+                                         void (*hdr)(void *args), void *args)
+{
+    struct x9555_pin_slot *slot;
+    rt_uint8_t bit;
+
+    if (pin < PKG_X9555_PIN_BASE)
+    {
+        return x9555_pin_native->pin_attach_irq ? x9555_pin_native->pin_attach_irq(parent, pin, mode, hdr, args) : -RT_ENOSYS;
+    }
+
+    slot = x9555_pin_slot_get(pin, &bit);
+    if (slot == RT_NULL)
+    {
+        return -RT_EINVAL;
+    }
+
+    /* input changes are only seen as edges, a level would have to be re-read while it lasts */
+    if ((mode != PIN_IRQ_MODE_RISING) && (mode != PIN_IRQ_MODE_FALLING) && (mode != PIN_IRQ_MODE_RISING_FALLING))
+    {
+        return -RT_ENOSYS;
+    }
+
+    x9555_lock_take(slot->device);
+    slot->irq[bit].pin = pin;
+    slot->irq[bit].mode = mode;
+    slot->irq[bit].hdr = hdr;
+    slot->irq[bit].args = args;
+    rt_mutex_release(&slot->device->lock);
+
+    return RT_EOK;
+}
+
+static rt_err_t x9555_pin_ops_detach_irq(struct rt_device *parent, rt_base_t pin)
+{
+    struct x9555_pin_slot *slot;
+    rt_uint8_t bit;
+
+    if (pin < PKG_X9555_PIN_BASE)
+    {
+        return x9555_pin_native->pin_detach_irq ? x9555_pin_native->pin_detach_irq(parent, pin) : -RT_ENOSYS;
+    }
+
+    slot = x9555_pin_slot_get(pin, &bit);
+    if (slot == RT_NULL)
+    {
+        return -RT_EINVAL;
+    }
+
+    x9555_lock_take(slot->device);
+    slot->irq_enabled &= ~(1 << bit);
+    slot->irq_fire &= ~(1 << bit);
+    slot->irq[bit].pin = PIN_IRQ_PIN_NONE;
+    slot->irq[bit].hdr = RT_NULL;
+    slot->irq[bit].args = RT_NULL;
+    rt_mutex_release(&slot->device->lock);
+
+    return RT_EOK;
+}
+
+static rt_err_t x9555_pin_ops_irq_enable(struct rt_device *parent, rt_base_t pin, rt_uint8_t enabled)
+{
+    struct x9555_pin_slot *slot;
+    rt_err_t result = RT_EOK;
+    rt_uint8_t bit;
+
+    if (pin < PKG_X9555_PIN_BASE)
+    {
+        return x9555_pin_native->pin_irq_enable ? x9555_pin_native->pin_irq_enable(parent, pin, enabled) : -RT_ENOSYS;
+    }
+
+    slot = x9555_pin_slot_get(pin, &bit);
+    if (slot == RT_NULL)
+    {
+        return -RT_EINVAL;
+    }
+
+    x9555_lock_take(slot->device);
+    if (enabled == PIN_IRQ_DISABLE)
+    {
+        slot->irq_enabled &= ~(1 << bit);
+    }
+    else if (slot->irq[bit].hdr != RT_NULL)
+    {
+        slot->irq_enabled |= (1 << bit);
+    }
+    else
+    {
+        result = -RT_ENOSYS;
+    }
+    rt_mutex_release(&slot->device->lock);
+
+    return result;
+}
+
+/* must be called with device->lock held, flags the rt_pin_attach_irq() handlers for the worker */
+static void x9555_pin_ops_dispatch(x9555_device_t device, rt_uint16_t old_value, rt_uint16_t new_value)
+{
+    struct x9555_pin_slot *slot = device->pin_slot;
+    rt_uint16_t changed, fire = 0;
+    rt_uint8_t bit;
+
+    if (slot == RT_NULL)
+    {
+        return;
+    }
+
+    changed = (old_value ^ new_value) & slot->irq_enabled;
+    for (bit = 0; bit < 16; bit++)
+    {
+        if (!(changed & (1 << bit)))
+        {
+            continue;
+        }
+
+        switch (slot->irq[bit].mode)
+        {
+        case PIN_IRQ_MODE_RISING:
+            fire |= new_value & (1 << bit);
+            break;
+        case PIN_IRQ_MODE_FALLING:
+            fire |= ~new_value & (1 << bit);
+            break;
+        default:
+            fire |= 1 << bit;
+            break;
+        }
+    }
+
+    if (fire)
+    {
+        /* several edges of one pin before the worker gets to it are one call */
+        slot->irq_fire |= fire;
+        x9555_worker_notify(device, X9555_EVENT_WAKE);
+    }
+}
+
+/* called from the worker without device->lock, the handlers may use any x9555 API */
+static void x9555_pin_ops_fire(x9555_device_t device)
+{
+    struct x9555_pin_slot *slot = device->pin_slot;
+    struct rt_pin_irq_hdr irq[16];
+    rt_uint16_t fire;
+    rt_uint8_t bit, count = 0, i;
+
+    if ((slot == RT_NULL) || (slot->irq_fire == 0))
+    {
+        return;
+    }
+
+    x9555_lock_take(device);
+    fire = slot->irq_fire & slot->irq_enabled;
+    slot->irq_fire = 0;
+    for (bit = 0; bit < 16; bit++)
+    {
+        if (fire & (1 << bit))
+        {
+            irq[count++] = slot->irq[bit];
+        }
+    }
+    rt_mutex_release(&device->lock);
+
+    for (i = 0; i < count; i++)
+    {
+        irq[i].hdr(irq[i].args);
+    }
+}
+
+/* takes the first free range of 16 pin numbers and wraps the "pin" device ops on first use */
+static rt_err_t x9555_pin_ops_attach(x9555_device_t device)
+{
+    struct x9555_pin_slot *slot;
+    int index;
+
+    slot = rt_calloc(1, sizeof(struct x9555_pin_slot));
+    if (slot == RT_NULL)
+    {
+        return -RT_ENOMEM;
+    }
+    slot->device = device;
+    for (index = 0; index < 16; index++)
+    {
+        slot->irq[index].pin = PIN_IRQ_PIN_NONE;
+    }
+
+    rt_enter_critical();
+    if (x9555_pin_device == RT_NULL)
+    {
+        x9555_pin_device = (struct rt_device_pin *)rt_device_find("pin");
+        if (x9555_pin_device != RT_NULL)
+        {
+            /* keep whatever else the MCU driver provides */
+            x9555_pin_native = x9555_pin_device->ops;
+            x9555_pin_ops = *x9555_pin_native;
+            x9555_pin_ops.pin_mode = x9555_pin_ops_mode;
+            x9555_pin_ops.pin_write = x9555_pin_ops_write;
+            x9555_pin_ops.pin_read = x9555_pin_ops_read;
+            x9555_pin_ops.pin_attach_irq = x9555_pin_ops_attach_irq;
+            x9555_pin_ops.pin_detach_irq = x9555_pin_ops_detach_irq;
+            x9555_pin_ops.pin_irq_enable = x9555_pin_ops_irq_enable;
+            x9555_pin_device->ops = &x9555_pin_ops;
+        }
+    }
+
+    for (index = 0; index < PKG_X9555_PIN_DEVICES_MAX; index++)
+    {
+        if (x9555_pin_slots[index] == RT_NULL)
+        {
+            slot->base = PKG_X9555_PIN_BASE + index * 16;
+            x9555_pin_slots[index] = slot;
+            break;
+        }
+    }
+    rt_exit_critical();
+
+    if ((x9555_pin_device == RT_NULL) || (index == PKG_X9555_PIN_DEVICES_MAX))
+    {
+        if (index < PKG_X9555_PIN_DEVICES_MAX)
+        {
+            x9555_pin_slots[index] = RT_NULL;
+        }
+        rt_free(slot);
+        return (x9555_pin_device == RT_NULL) ? -RT_ENOSYS : -RT_EFULL;
+    }
+
+    device->pin_slot = slot;
+    return RT_EOK;
+}
+
+static void x9555_pin_ops_detach(x9555_device_t device)
+{
+    struct x9555_pin_slot *slot = device->pin_slot;
+
+    if (slot == RT_NULL)
+    {
+        return;
+    }
+
+    rt_enter_critical();
+    x9555_pin_slots[(slot->base - PKG_X9555_PIN_BASE) / 16] = RT_NULL;
+    rt_exit_critical();
+
+    device->pin_slot = RT_NULL;
+    rt_free(slot);
+}
+
+/**
+ * This function gets the rt pin number of an x9555 pin, for rt_pin_mode(), rt_pin_write(),
+ * rt_pin_read() and rt_pin_attach_irq().
+ *
+ * @param device the pointer of device driver structure
+ * @param pin the x9555 pin
+ *
+ * @return the rt pin number, -1 if the pin is invalid or the device got no pin range
+ */
+rt_base_t x9555_pin_number(x9555_device_t device, rt_uint8_t pin)
+{
+    rt_int8_t bit;
+
+    RT_ASSERT(device);
+
+    bit = x9555_pin_to_bit(pin);
+    if ((bit < 0) || (device->pin_slot == RT_NULL))
+    {
+        return -1;
+    }
+
+    return device->pin_slot->base + bit;
+}
+#endif /* PKG_USING_X9555_PIN_OPS */
+
+#ifdef PKG_USING_X9555_DEVICE
+/* every input change wakes poll()/select() and rx_indicate, nothing else is needed from the bus */
+static void x9555_device_notify(x9555_device_t device)
+{
+    device->changed = RT_TRUE;
+
+    if (device->parent.rx_indicate != RT_NULL)
+    {
+        device->parent.rx_indicate(&device->parent, sizeof(rt_uint16_t));
+    }
+#ifdef RT_USING_POSIX_DEVIO
+    rt_wqueue_wakeup(&device->parent.wait_queue, (void *)POLLIN);
+#endif
+}
+#endif
+
+/* must be called with device->lock held, so there is only one producer at a time */
+static void x9555_input_update(x9555_device_t device, rt_uint16_t new_value, rt_tick_t tick)
+{
+    rt_uint16_t old_value = device->input_state;
+
+#ifdef PKG_USING_X9555_PIN_OPS
+    device->input_valid = RT_TRUE;
+#endif
+    if (new_value == old_value)
+    {
+        return;
+    }
+
+    device->input_state = new_value;
+
+#ifdef PKG_USING_X9555_EVENT_RING
+    x9555_event_ring_push(device, tick, old_value, new_value);
+#endif
+#ifdef PKG_USING_X9555_EDGE_COUNTER
+    x9555_edge_count(device, old_value, new_value);
+#endif
+#ifdef PKG_USING_X9555_PIN_WAIT
+    x9555_pin_wait_wakeup(device);
+#endif
+#ifdef PKG_USING_X9555_PIN_OPS
+    x9555_pin_ops_dispatch(device, old_value, new_value);
+#endif
+#ifdef PKG_USING_X9555_DEVICE
+    x9555_device_notify(device);
+#endif
+}
+
+static void x9555_input_service(x9555_device_t device, rt_tick_t tick)
+{
+    rt_uint8_t read_value_buff[2] = {'\0'};
+    rt_err_t result;
+
+    x9555_lock_take(device);
+
+    /* reading the input pair also clears the interrupt */
+    result = x9555_read_bytes(device, X9555_Register_Input_Port_0, read_value_buff, 2, X9555_PRIO_IRQ);
+#ifdef PKG_USING_X9555_LATENCY
+    device->read_timestamp = x9555_timestamp_get();
+#endif
+    if (result == RT_EOK)
+    {
+        x9555_input_update(device, read_value_buff[0] | (read_value_buff[1] << 8), tick);
+    }
+
+    rt_mutex_release(&device->lock);
+}
+
+#ifdef PKG_USING_X9555_PIN_GROUP
+#define X9555_GROUP_WIDTH_MAX   32
+
+/*
+ * The pins a group has on one device. Group value -> device value goes through one table
+ * per group nibble, device value -> group value through one table per device nibble.
+ */
+struct x9555_pin_group_part
+{
+    x9555_device_t device;
+    rt_uint16_t mask;
+    rt_uint8_t gather_nibbles; // device nibbles holding group pins
+    rt_uint16_t scatter[X9555_GROUP_WIDTH_MAX / 4][16];
+    rt_uint32_t gather[4][16];
+};
+
+struct x9555_pin_group
+{
+    rt_uint8_t width;
+    rt_uint8_t part_count;
+    struct x9555_pin_group_part parts[];
+};
+
+/**
+ * This function creates a pin group, pins[i] is bit i of the group value.
+ * The pins may be spread over both ports and over several devices.
+ *
+ * @param pins the group pins, least significant bit first
+ * @param count the number of pins, 1 ~ 32
+ *
+ * @return the pin group, RT_NULL on error
+ */
+x9555_pin_group_t x9555_pin_group_create(const struct x9555_group_pin *pins, rt_uint8_t count)
+{
+    x9555_pin_group_t group;
+    struct x9555_pin_group_part *part;
+    x9555_device_t devices[X9555_GROUP_WIDTH_MAX];
+    rt_uint8_t part_count = 0;
+    rt_int8_t bit;
+    int i, j, value;
+
+    RT_ASSERT(pins);
+
+    if ((count == 0) || (count > X9555_GROUP_WIDTH_MAX))
+    {
+        LOG_E("The x9555 pin group width must be 1 ~ %d. Please try again.", X9555_GROUP_WIDTH_MAX);
+        return RT_NULL;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        RT_ASSERT(pins[i].device);
+
+        for (j = 0; (j < part_count) && (devices[j] != pins[i].device); j++);
+        if (j == part_count)
+        {
+            devices[part_count++] = pins[i].device;
+        }
+    }
+
+    group = rt_calloc(1, sizeof(struct x9555_pin_group) + part_count * sizeof(struct x9555_pin_group_part));
+    if (group == RT_NULL)
+    {
+        LOG_E("Can't allocate memory for x9555 pin group.");
+        return RT_NULL;
+    }
+    group->width = count;
+    group->part_count = part_count;
+
+    for (i = 0; i < count; i++)
+    {
+        bit = x9555_pin_to_bit(pins[i].pin);
+        for (j = 0; devices[j] != pins[i].device; j++);
+        part = &group->parts[j];
+
+        if ((bit < 0) || (part->mask & (1 << bit)))
+        {
+            LOG_E("The x9555 pin %d don't found or is used twice. Please try again.", pins[i].pin);
+            rt_free(group);
+            return RT_NULL;
+        }
+
+        part->device = pins[i].device;
+        part->mask |= (1 << bit);
+        part->gather_nibbles |= (1 << (bit / 4));
+
+        /* every table entry whose index has the pin's bit set carries the pin */
+        for (value = 0; value < 16; value++)
+        {
+            if (value & (1 << (i % 4)))
+            {
+                part->scatter[i / 4][value] |= (1 << bit);
+            }
+            if (value & (1 << (bit % 4)))
+            {
+                part->gather[bit / 4][value] |= (1UL << i);
+            }
+        }
+    }
+
+    return group;
+}
+
+void x9555_pin_group_delete(x9555_pin_group_t group)
+{
+    RT_ASSERT(group);
+
+    rt_free(group);
+}
+
+/**
+ * This function writes a group value, with one masked transaction per device of the group.
+ * Devices are written one after another, not atomically with respect to each other.
+ *
+ * @param group the pin group
+ * @param value the group value, bit i goes to pins[i]
+ */
+rt_err_t x9555_pin_group_write(x9555_pin_group_t group, rt_uint32_t value)
+{
+    struct x9555_pin_group_part *part;
+    rt_uint16_t device_value;
+    rt_err_t result = RT_EOK;
+    int i, n;
+
+    RT_ASSERT(group);
+
+    for (i = 0; i < group->part_count; i++)
+    {
+        part = &group->parts[i];
+        device_value = 0;
+        for (n = 0; n < (group->width + 3) / 4; n++)
+        {
+            device_value |= part->scatter[n][(value >> (n * 4)) & 0x0f];
+        }
+
+        if (x9555_set_mask16(part->device, part->mask, device_value) != RT_EOK)
+        {
+            result = -RT_ERROR;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * This function reads a group value, with one input pair read per device of the group.
+ *
+ * @param group the pin group
+ * @param value the group value result, bit i comes from pins[i]
+ */
+rt_err_t x9555_pin_group_read(x9555_pin_group_t group, rt_uint32_t *value)
+{
+    struct x9555_pin_group_part *part;
+    rt_uint8_t read_value_buff[2] = {'\0'};
+    rt_uint16_t device_value;
+    rt_err_t result = RT_EOK;
+    int i, n;
+
+    RT_ASSERT(group);
+    RT_ASSERT(value);
+
+    *value = 0;
+    for (i = 0; i < group->part_count; i++)
+    {
+        part = &group->parts[i];
+
+        x9555_lock_take(part->device);
+        if (x9555_read_bytes(part->device, X9555_Register_Input_Port_0, read_value_buff, 2, X9555_PRIO_NORMAL) != RT_EOK)
+        {
+            rt_mutex_release(&part->device->lock);
+            result = -RT_ERROR;
+            continue;
+        }
+        device_value = read_value_buff[0] | (read_value_buff[1] << 8);
+        x9555_input_update(part->device, device_value, rt_tick_get());
+        rt_mutex_release(&part->device->lock);
+
+        for (n = 0; n < 4; n++)
+        {
+            if (part->gather_nibbles & (1 << n))
+            {
+                *value |= part->gather[n][(device_value >> (n * 4)) & 0x0f];
+            }
+        }
+    }
+
+    return result;
+}
+#endif /* PKG_USING_X9555_PIN_GROUP */
+
+#ifdef PKG_USING_X9555_CAPTURE
+#define X9555_CAPTURE_RECORD_SIZE   4
+
+/* the input pair register toggles inside one read, so a read of 2n bytes returns n 16-bit samples back to back */
+static rt_err_t x9555_capture_read(x9555_device_t device, rt_uint16_t *samples, rt_size_t count)
+{
+    rt_uint8_t *bytes = (rt_uint8_t *)samples;
+    rt_err_t result;
+    rt_size_t i;
+
+    x9555_lock_take(device);
+
+    result = x9555_read_bytes(device, X9555_Register_Input_Port_0, bytes, count * 2, X9555_PRIO_BULK);
+    if (result == RT_EOK)
+    {
+        /* in place, sample i is built from the two bytes it occupies */
+        for (i = 0; i < count; i++)
+        {
+            samples[i] = bytes[i * 2] | (bytes[i * 2 + 1] << 8);
+        }
+        /* the read released INT, keep the snapshot and its consumers up to date */
+        x9555_input_update(device, samples[count - 1], rt_tick_get());
+    }
+
+    rt_mutex_release(&device->lock);
+
+    return result;
+}
+
+/**
+ * This function samples the input pair back to back at the full bus rate, in reads of
+ * PKG_X9555_CAPTURE_CHUNK samples with a few bus clocks of gap between two reads.
+ *
+ * @param device the pointer of device driver structure
+ * @param samples the buffer to store the samples, bit 0 ~ 7 port 0, bit 8 ~ 15 port 1
+ * @param count the number of samples
+ * @param stats the sample rate reached, may be RT_NULL
+ */
+rt_err_t x9555_capture(x9555_device_t device, rt_uint16_t *samples, rt_size_t count, struct x9555_capture_stats *stats)
+{
+    rt_uint32_t start = x9555_timestamp_get();
+    rt_size_t done, len;
+    rt_err_t result = RT_EOK;
+    rt_uint32_t reads = 0;
+
+    RT_ASSERT(device);
+    RT_ASSERT(samples);
+
+    for (done = 0; done < count; done += len)
+    {
+        len = count - done;
+        if (len > PKG_X9555_CAPTURE_CHUNK)
+        {
+            len = PKG_X9555_CAPTURE_CHUNK;
+        }
+
+        result = x9555_capture_read(device, &samples[done], len);
+        if (result != RT_EOK)
+        {
+            break;
+        }
+        reads++;
+    }
+
+    if (stats != RT_NULL)
+    {
+        rt_memset(stats, 0, sizeof(struct x9555_capture_stats));
+        stats->samples = done;
+        stats->reads = reads;
+        stats->elapsed_us = x9555_timestamp_to_us(x9555_timestamp_get() - start);
+        stats->rate = stats->elapsed_us ? (rt_uint32_t)((rt_uint64_t)done * 1000000 / stats->elapsed_us) : 0;
+    }
+
+    return result;
+}
+
+struct x9555_capture_stream
+{
+    rt_uint16_t *buffer[2];
+    rt_size_t len[2];             // samples in the buffer, 0 ends the stream
+    struct rt_semaphore empty;
+    struct rt_semaphore full;
+    struct rt_semaphore done;
+    x9555_capture_output_t output;
+    void *user;
+    rt_uint8_t *records;          // run-length records waiting for the output
+    rt_size_t record_len;
+    rt_uint16_t value;
+    rt_uint32_t run;              // samples of value not written yet, 0 before the first sample
+    rt_uint32_t runs;
+    rt_uint32_t bytes;
+    rt_err_t error;
+};
+
+static void x9555_capture_flush(struct x9555_capture_stream *stream)
+{
+    if ((stream->record_len > 0) && (stream->error == RT_EOK))
+    {
+        if (stream->output(stream->user, stream->records, stream->record_len) != stream->record_len)
+        {
+            stream->error = -RT_EIO;
+        }
+        stream->bytes += stream->record_len;
+    }
+    stream->record_len = 0;
+}
+
+/* a record is the value and the run length, little endian 16-bit each */
+static void x9555_capture_emit(struct x9555_capture_stream *stream)
+{
+    rt_uint8_t *record = &stream->records[stream->record_len];
+
+    record[0] = stream->value & 0xff;
+    record[1] = stream->value >> 8;
+    record[2] = stream->run & 0xff;
+    record[3] = stream->run >> 8;
+    stream->record_len += X9555_CAPTURE_RECORD_SIZE;
+    stream->runs++;
+
+    if (stream->record_len == PKG_X9555_CAPTURE_CHUNK * X9555_CAPTURE_RECORD_SIZE)
+    {
+        x9555_capture_flush(stream);
+    }
+}
+
+/* compresses and writes one buffer while the caller reads the other one */
+static void x9555_capture_encoder(void *parameter)
+{
+    struct x9555_capture_stream *stream = (struct x9555_capture_stream *)parameter;
+    rt_uint16_t *samples;
+    rt_size_t i, len;
+    int index = 0;
+
+    while (1)
+    {
+        rt_sem_take(&stream->full, RT_WAITING_FOREVER);
+        samples = stream->buffer[index];
+        len = stream->len[index];
+        if (len == 0)
+        {
+            break;
+        }
+
+        for (i = 0; i < len; i++)
+        {
+            if ((stream->run > 0) && ((samples[i] != stream->value) || (stream->run == 0xffff)))
+            {
+                x9555_capture_emit(stream);
+                stream->run = 0;
+            }
+            stream->value = samples[i];
+            stream->run++;
+        }
+
+        rt_sem_release(&stream->empty);
+        index ^= 1;
+    }
+
+    if (stream->run > 0)
+    {
+        x9555_capture_emit(stream);
+    }
+    x9555_capture_flush(stream);
+
+    rt_sem_release(&stream->done);
+}
+
+/**
+ * This function captures the input pair continuously into a double buffer, the caller thread
+ * reads one buffer while an encoder thread run-length compresses the other one and hands the
+ * records to output. A record is 4 bytes: the 16-bit input value and the number of samples it
+ * lasted, both little endian.
+ *
+ * @param device the pointer of device driver structure
+ * @param count the number of samples to capture
+ * @param output called with the compressed records, must return size on success
+ * @param user passed to output, e.g. an rt_ringbuffer for x9555_capture_ringbuffer()
+ * @param stats the sample rate reached and the compressed size, may be RT_NULL
+ */
+rt_err_t x9555_capture_stream(x9555_device_t device, rt_uint32_t count, x9555_capture_output_t output, void *user,
+                              struct x9555_capture_stats *stats)
+{
+    struct x9555_capture_stream stream;
+    rt_thread_t encoder;
+    rt_uint32_t start, now, done = 0, reads = 0;
+    rt_uint64_t elapsed_us = 0;
+    rt_size_t len;
+    rt_err_t result = RT_EOK;
+    int index = 0;
+
+    RT_ASSERT(device);
+    RT_ASSERT(output);
+
+    rt_memset(&stream, 0, sizeof(stream));
+    stream.output = output;
+    stream.user = user;
+    stream.buffer[0] = rt_malloc(PKG_X9555_CAPTURE_CHUNK * sizeof(rt_uint16_t) * 2);
+    stream.records = rt_malloc(PKG_X9555_CAPTURE_CHUNK * X9555_CAPTURE_RECORD_SIZE);
+    if ((stream.buffer[0] == RT_NULL) || (stream.records == RT_NULL))
+    {
+        rt_free(stream.buffer[0]);
+        rt_free(stream.records);
+        return -RT_ENOMEM;
+    }
+    stream.buffer[1] = stream.buffer[0] + PKG_X9555_CAPTURE_CHUNK;
+
+    rt_sem_init(&stream.empty, "x9555e", 2, RT_IPC_FLAG_FIFO);
+    rt_sem_init(&stream.full, "x9555f", 0, RT_IPC_FLAG_FIFO);
+    rt_sem_init(&stream.done, "x9555d", 0, RT_IPC_FLAG_FIFO);
+
+    encoder = rt_thread_create("x9555c", x9555_capture_encoder, &stream,
+                               PKG_X9555_THREAD_STACK_SIZE, PKG_X9555_THREAD_PRIORITY, 10);
+    if (encoder == RT_NULL)
+    {
+        result = -RT_ENOMEM;
+        goto __exit;
+    }
+    rt_thread_startup(encoder);
+
+    start = x9555_timestamp_get();
+    while ((done < count) && (result == RT_EOK))
+    {
+        len = count - done;
+        if (len > PKG_X9555_CAPTURE_CHUNK)
+        {
+            len = PKG_X9555_CAPTURE_CHUNK;
+        }
+
+        /* the time spent waiting for the encoder is a gap in the samples as well */
+        rt_sem_take(&stream.empty, RT_WAITING_FOREVER);
+        result = (stream.error != RT_EOK) ? stream.error : x9555_capture_read(device, stream.buffer[index], len);
+        now = x9555_timestamp_get();
+        elapsed_us += x9555_timestamp_to_us(now - start);
+        start = now;
+
+        if (result != RT_EOK)
+        {
+            rt_sem_release(&stream.empty);
+            break;
+        }
+
+        stream.len[index] = len;
+        rt_sem_release(&stream.full);
+        index ^= 1;
+        done += len;
+        reads++;
+    }
+
+    /* an empty buffer ends the stream once the encoder is done with the last one */
+    rt_sem_take(&stream.empty, RT_WAITING_FOREVER);
+    stream.len[index] = 0;
+    rt_sem_release(&stream.full);
+    rt_sem_take(&stream.done, RT_WAITING_FOREVER);
+    if (result == RT_EOK)
+    {
+        result = stream.error;
+    }
+
+    if (stats != RT_NULL)
+    {
+        stats->samples = done;
+        stats->reads = reads;
+        stats->elapsed_us = (rt_uint32_t)elapsed_us;
+        stats->rate = elapsed_us ? (rt_uint32_t)((rt_uint64_t)done * 1000000 / elapsed_us) : 0;
+        stats->runs = stream.runs;
+        stats->bytes = stream.bytes;
+    }
+
+__exit:
+    rt_sem_detach(&stream.done);
+    rt_sem_detach(&stream.full);
+    rt_sem_detach(&stream.empty);
+    rt_free(stream.records);
+    rt_free(stream.buffer[0]);
+
+    return result;
+}
+
+/**
+ * Output for x9555_capture_stream() into an rt_ringbuffer given as user, a consumer thread
+ * drains it meanwhile. The capture stops with an error if the ring runs full.
+ */
+rt_size_t x9555_capture_ringbuffer(void *user, const void *data, rt_size_t size)
+{
+    return rt_ringbuffer_put((struct rt_ringbuffer *)user, (const rt_uint8_t *)data, size);
+}
+#endif /* PKG_USING_X9555_CAPTURE */
+
+#ifdef PKG_USING_X9555_DEVICE
+/*
+ * Every x9555 device is also registered as an rt_device "x9555_N". read() returns the 16-bit input
+ * snapshot, write() takes struct x9555_output16 elements, poll()/select() report POLLIN once the
+ * interrupt or poll path saw an input change since the last read(), without any bus traffic.
+ */
+static rt_ssize_t x9555_device_read(rt_device_t parent, rt_off_t pos, void *buffer, rt_size_t size)
+{
+    x9555_device_t device = rt_container_of(parent, struct x9555_device, parent);
+    rt_uint16_t value;
+
+    if (size < sizeof(value))
+    {
+        return -RT_EINVAL;
+    }
+
+    /* the worker sets input_state and changed under device->lock, a change between the two steps here would be lost */
+    x9555_lock_take(device);
+    device->changed = RT_FALSE;
+    value = device->input_state;
+    rt_mutex_release(&device->lock);
+    rt_memcpy(buffer, &value, sizeof(value));
+
+    return sizeof(value);
+}
+
+static rt_ssize_t x9555_device_write(rt_device_t parent, rt_off_t pos, const void *buffer, rt_size_t size)
+{
+    x9555_device_t device = rt_container_of(parent, struct x9555_device, parent);
+    struct x9555_output16 output;
+    rt_size_t i, count = size / sizeof(output);
+
+    for (i = 0; i < count; i++)
+    {
+        rt_memcpy(&output, (const rt_uint8_t *)buffer + i * sizeof(output), sizeof(output));
+        if (x9555_set_mask16(device, output.mask, output.value) != RT_EOK)
+        {
+            break;
+        }
+    }
+
+    return i * sizeof(output);
+}
+
+static rt_err_t x9555_device_control(rt_device_t parent, int cmd, void *args)
+{
+    x9555_device_t device = rt_container_of(parent, struct x9555_device, parent);
+
+    if (args == RT_NULL)
+    {
+        return -RT_EINVAL;
+    }
+
+    switch (cmd)
+    {
+    case X9555_CTRL_PIN_MODE:
+        return x9555_pin_mode(device, ((struct x9555_ctrl_pin *)args)->pin, ((struct x9555_ctrl_pin *)args)->mode);
+
+    case X9555_CTRL_PORT_MODE:
+        return x9555_port_mode(device, ((struct x9555_ctrl_port *)args)->port, ((struct x9555_ctrl_port *)args)->mode);
+
+    case X9555_CTRL_BURST:
+        return x9555_port_write16_burst(device, ((struct x9555_ctrl_burst *)args)->values,
+                                        ((struct x9555_ctrl_burst *)args)->count);
+
+    case X9555_CTRL_INPUT_READ:
+        return x9555_input_read16(device, (rt_uint16_t *)args);
+
+    default:
+        return -RT_EINVAL;
+    }
+}
+
+#ifdef RT_USING_DEVICE_OPS
+static const struct rt_device_ops x9555_device_ops =
+{
+    RT_NULL,
+    RT_NULL,
+    RT_NULL,
+    x9555_device_read,
+    x9555_device_write,
+    x9555_device_control
+};
+#endif
+
+#ifdef RT_USING_POSIX_DEVIO
+static int x9555_fops_open(struct dfs_file *fd)
+{
+    return rt_device_open((rt_device_t)fd->vnode->data, RT_DEVICE_OFLAG_RDWR);
+}
+
+static int x9555_fops_close(struct dfs_file *fd)
+{
+    return rt_device_close((rt_device_t)fd->vnode->data);
+}
+
+static int x9555_fops_ioctl(struct dfs_file *fd, int cmd, void *args)
+{
+    return rt_device_control((rt_device_t)fd->vnode->data, cmd, args);
+}
+
+static int x9555_fops_read(struct dfs_file *fd, void *buf, size_t count)
+{
+    return rt_device_read((rt_device_t)fd->vnode->data, -1, buf, count);
+}
+
+static int x9555_fops_write(struct dfs_file *fd, const void *buf, size_t count)
+{
+    return rt_device_write((rt_device_t)fd->vnode->data, -1, buf, count);
+}
+
+static int x9555_fops_poll(struct dfs_file *fd, struct rt_pollreq *req)
+{
+    rt_device_t parent = (rt_device_t)fd->vnode->data;
+    x9555_device_t device = rt_container_of(parent, struct x9555_device, parent);
+
+    rt_poll_add(&parent->wait_queue, req);
+
+    return device->changed ? POLLIN : 0;
+}
+
+static const struct dfs_file_ops x9555_fops =
+{
+    x9555_fops_open,
+    x9555_fops_close,
+    x9555_fops_ioctl,
+    x9555_fops_read,
+    x9555_fops_write,
+    RT_NULL, /* flush */
+    RT_NULL, /* lseek */
+    RT_NULL, /* getdents */
+    x9555_fops_poll,
+};
+#endif /* RT_USING_POSIX_DEVIO */
+
+/* takes the first free name x9555_0, x9555_1, ... */
+static rt_err_t x9555_device_register(x9555_device_t device)
+{
+    char name[RT_NAME_MAX];
+    int index;
+
+    device->parent.type = RT_Device_Class_Miscellaneous;
+#ifdef RT_USING_DEVICE_OPS
+    device->parent.ops = &x9555_device_ops;
+#else
+    device->parent.init = RT_NULL;
+    device->parent.open = RT_NULL;
+    device->parent.close = RT_NULL;
+    device->parent.read = x9555_device_read;
+    device->parent.write = x9555_device_write;
+    device->parent.control = x9555_device_control;
+#endif
+
+    for (index = 0; ; index++)
+    {
+        if (rt_snprintf(name, sizeof(name), "x9555_%d", index) >= (int)sizeof(name))
+        {
+            LOG_E("The x9555 device names are used up. Please raise RT_NAME_MAX.");
+            return -RT_EFULL;
+        }
+        if ((rt_device_find(name) == RT_NULL) &&
+            (rt_device_register(&device->parent, name, RT_DEVICE_FLAG_RDWR) == RT_EOK))
+        {
+            break;
+        }
+    }
+
+#ifdef RT_USING_POSIX_DEVIO
+    /* set after registering, rt_device_register() clears it */
+    device->parent.fops = &x9555_fops;
+#endif
+
+    return RT_EOK;
+}
+#endif /* PKG_USING_X9555_DEVICE */
+
+#ifdef PKG_USING_X9555_SCRUBBER
+#define X9555_SCRUB_READ_BYTES  5 // address, command, address, port 0, port 1
+
+/**
+ * Called from the x9555 worker thread after the scrubber has found a register pair
+ * which differs from the driver state and has written the whole state back.
+ *
+ * @param args the x9555 device which has been repaired
+ */
+__attribute__((weak)) void call_scrub_repair(void *args)
+{
+}
+
+static void x9555_scrub_timeout(void *parameter)
+{
+    x9555_device_t device = (x9555_device_t)parameter;
+
+    x9555_worker_notify(device, X9555_EVENT_SCRUB);
+}
+
+/* must be called with device->lock held, outputs go first so no pin drives a stale level */
+static rt_err_t x9555_scrub_repair(x9555_device_t device)
+{
+    const rt_uint8_t registers[3] = {X9555_Register_Output_Port_0, X9555_Register_Polarity_Inversion_Port_0,
+                                     X9555_Register_Configuration_Port_0};
+    const rt_uint16_t states[3] = {device->output_state, device->polarity_state, device->config_state};
+    struct rt_i2c_msg msgs[3];
+    rt_uint8_t buf[3][3];
+    int i;
+
+    for (i = 0; i < 3; i++)
+    {
+        buf[i][0] = registers[i];
+        buf[i][1] = states[i] & 0xff;
+        buf[i][2] = states[i] >> 8;
+
+        msgs[i].addr = device->device_address;
+        msgs[i].flags = RT_I2C_WR;
+        msgs[i].buf = buf[i];
+        msgs[i].len = 3;
+    }
+
+#ifdef PKG_USING_X9555_BUS_SCHEDULER
+    return x9555_bus_transfer(device, msgs, 3, X9555_PRIO_NORMAL);
+#else
+    return x9555_i2c_transfer(device->i2c, msgs, 3);
+#endif
+}
+
+/* reads back one register pair per tick and compares it with the shadow */
+static void x9555_scrub_service(x9555_device_t device)
+{
+    rt_uint8_t read_value_buff[2] = {'\0'};
+    rt_uint8_t register_address;
+    rt_uint16_t expected;
+    rt_bool_t repaired = RT_FALSE;
+
+    x9555_lock_take(device);
+
+    switch (device->scrub_index)
+    {
+    case 0:
+        register_address = X9555_Register_Configuration_Port_0;
+        expected = device->config_state;
+        break;
+    case 1:
+        register_address = X9555_Register_Polarity_Inversion_Port_0;
+        expected = device->polarity_state;
+        break;
+    default:
+        register_address = X9555_Register_Output_Port_0;
+        expected = device->output_state;
+        break;
+    }
+    device->scrub_index = (device->scrub_index + 1) % 3;
+
+    if (x9555_read_bytes(device, register_address, read_value_buff, 2, X9555_PRIO_BULK) == RT_EOK)
+    {
+        device->scrub.checks++;
+        if ((read_value_buff[0] | (read_value_buff[1] << 8)) != expected)
+        {
+            device->scrub.mismatches++;
+            LOG_W("x9555 device 0x%02x register 0x%02x reads 0x%04x, expected 0x%04x.", device->device_address,
+                  register_address, read_value_buff[0] | (read_value_buff[1] << 8), expected);
+
+            if (x9555_scrub_repair(device) == RT_EOK)
+            {
+#ifdef PKG_USING_X9555_WRITE_BACK
+                if (device->write_back)
+                {
+                    device->write_back->committed[0] = device->output_state;
+                    device->write_back->committed[1] = device->polarity_state;
+                    device->write_back->committed[2] = device->config_state;
+                }
+#endif
+                device->scrub.repairs++;
+                repaired = RT_TRUE;
+            }
+        }
+    }
+
+    rt_mutex_release(&device->lock);
+
+    if (repaired)
+    {
+        call_scrub_repair(device);
+    }
+}
+
+/**
+ * This function sets the bus budget of the register scrubber. Every check reads one
+ * register pair, so the Configuration/Polarity/Output set is covered in three checks.
+ *
+ * @param device the pointer of device driver structure
+ * @param bytes_per_second the bus bytes per second, 0 stops the scrubber
+ */
+rt_err_t x9555_scrub_budget_set(x9555_device_t device, rt_uint32_t bytes_per_second)
+{
+    rt_tick_t period;
+    RT_ASSERT(device);
+
+    rt_timer_stop(&device->scrub_timer);
+    if (bytes_per_second == 0)
+    {
+        return RT_EOK;
+    }
+
+    period = (rt_tick_t)((rt_uint64_t)X9555_SCRUB_READ_BYTES * RT_TICK_PER_SECOND / bytes_per_second);
+    if (period == 0)
+    {
+        period = 1;
+    }
+    rt_timer_control(&device->scrub_timer, RT_TIMER_CTRL_SET_TIME, &period);
+
+    return rt_timer_start(&device->scrub_timer);
+}
+
+/**
+ * This function gets the register scrubber statistics of a device.
+ *
+ * @param device the pointer of device driver structure
+ * @param stats the statistics result
+ * @param reset RT_TRUE to clear the statistics after reading
+ */
+rt_err_t x9555_scrub_stats_get(x9555_device_t device, struct x9555_scrub_stats *stats, rt_bool_t reset)
+{
+    RT_ASSERT(device);
+    RT_ASSERT(stats);
+
+    x9555_lock_take(device);
+    *stats = device->scrub;
+    if (reset)
+    {
+        rt_memset(&device->scrub, 0, sizeof(struct x9555_scrub_stats));
+    }
+    rt_mutex_release(&device->lock);
+
+    return RT_EOK;
+}
+#endif /* PKG_USING_X9555_SCRUBBER */
+
+#ifdef PKG_USING_X9555_SOFT_PWM
+#define X9555_PWM_WRITE_BYTES   4 // address, command, port 0, port 1
+/* up to this frequency a PWM output reads as blinking, above it as a dimming level */
+#define X9555_PWM_BLINK_MAX     10
+/* dimming below this frequency visibly flickers */
+#define X9555_PWM_FLICKER_FREE  200
+
+struct x9555_pwm_edge
+{
+    rt_tick_t offset;
+    rt_uint16_t value;
+};
+
+struct x9555_pwm
+{
+    struct rt_timer timer;
+    rt_uint16_t frequency;
+    rt_uint16_t resolution;
+    rt_tick_t period;
+    rt_uint16_t channel_mask;
+    rt_uint16_t duty[16];
+    rt_bool_t running;
+    rt_bool_t dirty;
+
+    /* edge 0 raises every channel with a non-zero duty, then one edge per distinct fall time */
+    struct x9555_pwm_edge edges[17];
+    rt_uint8_t edge_count;
+    rt_uint8_t edge_index;
+    rt_tick_t period_start;
+
+    rt_uint32_t writes;
+    rt_uint32_t late;
+};
+
+/* must be called with device->lock held, rebuilds the sorted edge list of one period */
+static void x9555_pwm_schedule(struct x9555_pwm *pwm)
+{
+    rt_tick_t offsets[16];
+    rt_uint16_t falling[16];
+    rt_uint16_t value = 0;
+    rt_tick_t offset;
+    int count = 0;
+    int bit, i, j;
+
+    for (bit = 0; bit < 16; bit++)
+    {
+        if (!(pwm->channel_mask & (1 << bit)) || (pwm->duty[bit] == 0))
+        {
+            continue;
+        }
+
+        value |= (1 << bit);
+        if (pwm->duty[bit] >= pwm->resolution)
+        {
+            continue;
+        }
+
+        offset = (rt_tick_t)((rt_uint32_t)pwm->duty[bit] * pwm->period / pwm->resolution);
+
+        /* channels falling at the same tick share one write */
+        for (i = 0; (i < count) && (offsets[i] < offset); i++);
+        if ((i < count) && (offsets[i] == offset))
+        {
+            falling[i] |= (1 << bit);
+            continue;
+        }
+        for (j = count; j > i; j--)
+        {
+            offsets[j] = offsets[j - 1];
+            falling[j] = falling[j - 1];
+        }
+        offsets[i] = offset;
+        falling[i] = (1 << bit);
+        count++;
+    }
+
+    pwm->edges[0].offset = 0;
+    pwm->edges[0].value = value;
+    for (i = 0; i < count; i++)
+    {
+        value &= ~falling[i];
+        pwm->edges[i + 1].offset = offsets[i];
+        pwm->edges[i + 1].value = value;
+    }
+    pwm->edge_count = count + 1;
+    pwm->dirty = RT_FALSE;
+}
+
+static void x9555_pwm_timeout(void *parameter)
+{
+    x9555_device_t device = (x9555_device_t)parameter;
+
+    x9555_worker_notify(device, X9555_EVENT_PWM);
+}
+
+static void x9555_pwm_service(x9555_device_t device)
+{
+    struct x9555_pwm *pwm;
+    rt_tick_t now, deadline, delay;
+    rt_uint16_t output;
+
+    x9555_lock_take(device);
+
+    pwm = device->pwm;
+    if ((pwm == RT_NULL) || !pwm->running)
+    {
+        rt_mutex_release(&device->lock);
+        return;
+    }
+
+    now = rt_tick_get();
+    deadline = pwm->period_start + pwm->edges[pwm->edge_index].offset;
+    if ((rt_int32_t)(now - deadline) > 0)
+    {
+        pwm->late++;
+    }
+
+    /* one write carries every channel changing at this edge */
+    output = (device->output_state & ~pwm->channel_mask) | pwm->edges[pwm->edge_index].value;
+    if (output != device->output_state)
+    {
+        if (x9555_output_write16(device, output, X9555_ORDER_CHANGED_ONLY) == RT_EOK)
+        {
+            pwm->writes++;
+        }
+    }
+
+    if (++pwm->edge_index >= pwm->edge_count)
+    {
+        pwm->edge_index = 0;
+        pwm->period_start += pwm->period;
+        if ((rt_int32_t)(now - pwm->period_start) >= (rt_int32_t)pwm->period)
+        {
+            /* fell behind by a whole period, resynchronize instead of bursting */
+            pwm->period_start = now;
+        }
+        if (pwm->dirty)
+        {
+            x9555_pwm_schedule(pwm);
+        }
+    }
+
+    deadline = pwm->period_start + pwm->edges[pwm->edge_index].offset;
+    delay = ((rt_int32_t)(deadline - now) > 0) ? (deadline - now) : 1;
+    rt_timer_control(&pwm->timer, RT_TIMER_CTRL_SET_TIME, &delay);
+    rt_timer_start(&pwm->timer);
+
+    rt_mutex_release(&device->lock);
+}
+
+/**
+ * This function configures the soft PWM engine of a device.
+ * Edges are timed by the RT-Thread tick and every edge is one I2C write, so frequency * resolution
+ * must not exceed RT_TICK_PER_SECOND. Frequencies between X9555_PWM_BLINK_MAX and
+ * X9555_PWM_FLICKER_FREE are rejected, as dimming there flickers: the engine blinks, or dims with
+ * the few steps left at X9555_PWM_FLICKER_FREE and above, e.g. 200 Hz with 5 steps at a 1000 Hz tick.
+ *
+ * @param device the pointer of device driver structure
+ * @param frequency the PWM frequency in Hz
+ * @param resolution the number of duty steps per period
+ */
+rt_err_t x9555_pwm_config(x9555_device_t device, rt_uint16_t frequency, rt_uint16_t resolution)
+{
+    struct x9555_pwm *pwm;
+    int bit;
+    RT_ASSERT(device);
+
+    if ((frequency == 0) || (resolution == 0) || ((rt_uint32_t)frequency * resolution > RT_TICK_PER_SECOND))
+    {
+        LOG_E("The x9555 pwm needs frequency * resolution <= %d. Please try again.", RT_TICK_PER_SECOND);
+        return -RT_EINVAL;
+    }
+
+    if ((frequency > X9555_PWM_BLINK_MAX) && (frequency < X9555_PWM_FLICKER_FREE))
+    {
+        LOG_E("The x9555 pwm at %d Hz flickers, use <= %d Hz or >= %d Hz. Please try again.",
+              frequency, X9555_PWM_BLINK_MAX, X9555_PWM_FLICKER_FREE);
+        return -RT_EINVAL;
+    }
+
+    x9555_lock_take(device);
+
+    pwm = device->pwm;
+    if (pwm == RT_NULL)
+    {
+        pwm = rt_calloc(1, sizeof(struct x9555_pwm));
+        if (pwm == RT_NULL)
+        {
+            LOG_E("Can't allocate memory for x9555 pwm.");
+            rt_mutex_release(&device->lock);
+            return -RT_ENOMEM;
+        }
+        rt_timer_init(&pwm->timer, "x9555p", x9555_pwm_timeout, device, 1, RT_TIMER_FLAG_ONE_SHOT);
+        device->pwm = pwm;
+    }
+
+    pwm->frequency = frequency;
+    pwm->resolution = resolution;
+    pwm->period = RT_TICK_PER_SECOND / frequency;
+    for (bit = 0; bit < 16; bit++)
+    {
+        if (pwm->duty[bit] > resolution)
+        {
+            pwm->duty[bit] = resolution;
+        }
+    }
+    pwm->dirty = RT_TRUE;
+
+    rt_mutex_release(&device->lock);
+    return RT_EOK;
+}
+
+/**
+ * This function sets the duty of a PWM channel, it takes effect at the next period.
+ * The pin must already be in output mode.
+ *
+ * @param device the pointer of device driver structure
+ * @param pin the x9555 pin
+ * @param duty the high time in steps, 0 ~ resolution
+ */
+rt_err_t x9555_pwm_set(x9555_device_t device, rt_uint8_t pin, rt_uint16_t duty)
+{
+    rt_int8_t bit;
+    rt_err_t result = RT_EOK;
+    RT_ASSERT(device);
+
+    bit = x9555_pin_to_bit(pin);
+    if (bit < 0)
+    {
+        LOG_E("The x9555 pin don't found. Please try again.");
+        return -RT_ERROR;
+    }
+
+    x9555_lock_take(device);
+
+    if ((device->pwm == RT_NULL) || (duty > device->pwm->resolution))
+    {
+        LOG_E("The x9555 pwm is not configured or duty is out of range. Please try again.");
+        result = -RT_EINVAL;
+    }
+    else
+    {
+        device->pwm->channel_mask |= (1 << bit);
+        device->pwm->duty[bit] = duty;
+        device->pwm->dirty = RT_TRUE;
+    }
+
+    rt_mutex_release(&device->lock);
+    return result;
+}
+
+/**
+ * This function gives a pin back to normal output, it keeps its last level.
+ *
+ * @param device the pointer of device driver structure
+ * @param pin the x9555 pin
+ */
+rt_err_t x9555_pwm_release(x9555_device_t device, rt_uint8_t pin)
+{
+    rt_int8_t bit;
+    RT_ASSERT(device);
+
+    bit = x9555_pin_to_bit(pin);
+    if (bit < 0)
+    {
+        LOG_E("The x9555 pin don't found. Please try again.");
+        return -RT_ERROR;
+    }
+
+    x9555_lock_take(device);
+
+    if (device->pwm != RT_NULL)
+    {
+        device->pwm->channel_mask &= ~(1 << bit);
+        device->pwm->dirty = RT_TRUE;
+    }
+
+    rt_mutex_release(&device->lock);
+    return RT_EOK;
+}
+
+rt_err_t x9555_pwm_start(x9555_device_t device)
+{
+    RT_ASSERT(device);
+
+    x9555_lock_take(device);
+
+    if (device->pwm == RT_NULL)
+    {
+        rt_mutex_release(&device->lock);
+        LOG_E("The x9555 pwm is not configured. Please try again.");
+        return -RT_EINVAL;
+    }
+
+    x9555_pwm_schedule(device->pwm);
+    device->pwm->edge_index = 0;
+    device->pwm->period_start = rt_tick_get();
+    device->pwm->writes = 0;
+    device->pwm->late = 0;
+    device->pwm->running = RT_TRUE;
+
+    rt_mutex_release(&device->lock);
+
+    return x9555_worker_notify(device, X9555_EVENT_PWM);
+}
+
+rt_err_t x9555_pwm_stop(x9555_device_t device)
+{
+    RT_ASSERT(device);
+
+    x9555_lock_take(device);
+
+    if (device->pwm != RT_NULL)
+    {
+        device->pwm->running = RT_FALSE;
+        rt_timer_stop(&device->pwm->timer);
+    }
+
+    rt_mutex_release(&device->lock);
+    return RT_EOK;
+}
+
+/**
+ * This function reports the bus load of the soft PWM engine.
+ *
+ * @param device the pointer of device driver structure
+ * @param load the bus load result
+ */
+rt_err_t x9555_pwm_bus_load(x9555_device_t device, struct x9555_pwm_load *load)
+{
+    struct x9555_pwm *pwm;
+    RT_ASSERT(device);
+    RT_ASSERT(load);
+
+    x9555_lock_take(device);
+
+    pwm = device->pwm;
+    if (pwm == RT_NULL)
+    {
+        rt_mutex_release(&device->lock);
+        return -RT_EINVAL;
+    }
+
+    if (pwm->dirty)
+    {
+        x9555_pwm_schedule(pwm);
+    }
+
+    /* a period with no falling edge is a static level and costs no writes */
+    load->writes_per_second = (pwm->edge_count > 1) ? (rt_uint32_t)pwm->edge_count * (RT_TICK_PER_SECOND / pwm->period) : 0;
+    load->bytes_per_second = load->writes_per_second * X9555_PWM_WRITE_BYTES;
+    load->writes = pwm->writes;
+    load->late = pwm->late;
+
+    rt_mutex_release(&device->lock);
+    return RT_EOK;
+}
+#endif /* PKG_USING_X9555_SOFT_PWM */
+
+#ifdef PKG_USING_X9555_ISR_API
+/* the pending word packs the mask in the high half and the value in the low half */
+#define X9555_ISR_PENDING(mask, value)  (((rt_atomic_t)(mask) << 16) | (value))
+/* failed writes in a row before the pending changes are dropped */
+#define X9555_ISR_RETRY_MAX             3
+
+/**
+ * This function sets the outputs in mask to value from interrupt context. It never blocks,
+ * the change is merged into a pending word and written by the worker thread, so every
+ * change made before the worker runs goes out in one transaction.
+ *
+ * @param device the pointer of device driver structure
+ * @param mask the outputs to change, bit 0 ~ 7 port 0, bit 8 ~ 15 port 1
+ * @param value the new levels of the outputs in mask
+ */
+rt_err_t x9555_set_mask16_isr(x9555_device_t device, rt_uint16_t mask, rt_uint16_t value)
+{
+    rt_atomic_t pending, merged;
+    rt_uint16_t pending_mask, pending_value;
+
+    RT_ASSERT(device);
+
+    pending = rt_atomic_load(&device->isr_pending);
+    do
+    {
+        pending_mask = (rt_uint16_t)(pending >> 16);
+        pending_value = (rt_uint16_t)pending;
+        merged = X9555_ISR_PENDING(pending_mask | mask, (pending_value & ~mask) | (value & mask));
+    } while (!rt_atomic_compare_exchange_strong(&device->isr_pending, &pending, merged));
+
+    return x9555_worker_notify(device, X9555_EVENT_OUTPUT);
+}
+
+/**
+ * This function sets one output pin from interrupt context, see x9555_set_mask16_isr().
+ *
+ * @param device the pointer of device driver structure
+ * @param pin the x9555 pin
+ * @param pin_state X9555_PIN_LOW or X9555_PIN_HIGH
+ */
+rt_err_t x9555_pin_write_isr(x9555_device_t device, rt_uint8_t pin, rt_uint8_t pin_state)
+{
+    rt_int8_t bit = x9555_pin_to_bit(pin);
+
+    if (bit < 0)
+    {
+        return -RT_EINVAL;
+    }
+
+    return x9555_set_mask16_isr(device, 1 << bit, (pin_state == X9555_PIN_HIGH) ? (1 << bit) : 0);
+}
+
+/**
+ * This function returns the input snapshot of the interrupt/poll path, from any context.
+ *
+ * @param device the pointer of device driver structure
+ */
+rt_uint16_t x9555_input_isr(x9555_device_t device)
+{
+    RT_ASSERT(device);
+
+    return device->input_state;
+}
+
+/**
+ * This function returns the number of output changes from interrupt context that were
+ * dropped because the bus write failed X9555_ISR_RETRY_MAX times in a row.
+ *
+ * @param device the pointer of device driver structure
+ */
+rt_uint32_t x9555_isr_dropped(x9555_device_t device)
+{
+    RT_ASSERT(device);
+
+    return device->isr_dropped;
+}
+
+static void x9555_isr_output_service(x9555_device_t device)
+{
+    rt_atomic_t pending = rt_atomic_exchange(&device->isr_pending, 0);
+    rt_atomic_t current, merged;
+    rt_uint16_t mask = (rt_uint16_t)(pending >> 16);
+    rt_uint16_t value = (rt_uint16_t)pending;
+    rt_uint16_t current_mask;
+    rt_tick_t delay;
+    rt_err_t result;
+
+    if (mask == 0)
+    {
+        return;
+    }
+
+    x9555_lock_take(device);
+    result = x9555_output_write16(device, (device->output_state & ~mask) | (value & mask), X9555_ORDER_CHANGED_ONLY);
+    rt_mutex_release(&device->lock);
+
+    if (result == RT_EOK)
+    {
+        device->isr_retries = 0;
+        return;
+    }
+
+    if (++device->isr_retries > X9555_ISR_RETRY_MAX)
+    {
+        device->isr_retries = 0;
+        device->isr_dropped++;
+        LOG_E("The x9555 output change from interrupt context was dropped. Please try again.");
+        return;
+    }
+
+    /* put the bits back for the retry, a pin written again meanwhile keeps its newer level */
+    current = rt_atomic_load(&device->isr_pending);
+    do
+    {
+        current_mask = (rt_uint16_t)(current >> 16);
+        merged = X9555_ISR_PENDING(current_mask | mask, ((rt_uint16_t)current & current_mask) | (value & mask & ~current_mask));
+    } while (!rt_atomic_compare_exchange_strong(&device->isr_pending, &current, merged));
+
+    /* a bus that just failed rarely recovers at once, the retries back off so they span a real recovery window */
+    delay = rt_tick_from_millisecond(PKG_X9555_ISR_RETRY_MS << (device->isr_retries - 1));
+    if (delay == 0)
+    {
+        delay = 1;
+    }
+    rt_timer_control(&device->isr_retry_timer, RT_TIMER_CTRL_SET_TIME, &delay);
+    rt_timer_start(&device->isr_retry_timer);
+}
+
+static void x9555_isr_retry_timeout(void *parameter)
+{
+    x9555_worker_notify((x9555_device_t)parameter, X9555_EVENT_OUTPUT);
+}
+#endif /* PKG_USING_X9555_ISR_API */
+
+#ifdef PKG_USING_X9555_LATENCY
+/* bucket n holds [2^n, 2^(n + 1)) us, bucket 0 also holds 0 us, the last one everything above */
+static void x9555_latency_record(x9555_device_t device, rt_uint8_t type, rt_uint32_t timestamp)
+{
+    struct x9555_latency_histogram *histogram = &device->latency.histogram[type];
+    rt_uint32_t us = x9555_timestamp_to_us(timestamp);
+    rt_uint8_t bucket = 0;
+
+    while ((bucket < PKG_X9555_LATENCY_BUCKETS - 1) && (us >> (bucket + 1)))
+    {
+        bucket++;
+    }
+
+    histogram->bucket[bucket]++;
+    histogram->count++;
+    if (us > histogram->max_us)
+    {
+        histogram->max_us = us;
+    }
+}
+
+/* runs after the callback has returned, so recording stays off the interrupt path */
+static void x9555_latency_update(x9555_device_t device, rt_uint32_t wakeup, rt_uint32_t dispatch)
+{
+    x9555_lock_take(device);
+    x9555_latency_record(device, X9555_LATENCY_WAKEUP, wakeup - device->irq_timestamp);
+    x9555_latency_record(device, X9555_LATENCY_READ, device->read_timestamp - wakeup);
+    x9555_latency_record(device, X9555_LATENCY_DISPATCH, dispatch - device->read_timestamp);
+    x9555_latency_record(device, X9555_LATENCY_TOTAL, dispatch - device->irq_timestamp);
+    rt_mutex_release(&device->lock);
+}
+
+/**
+ * This function gets the interrupt latency histograms of a device: interrupt to worker wakeup,
+ * input read on the bus, read completion to callback dispatch and interrupt to dispatch.
+ *
+ * @param device the pointer of device driver structure
+ * @param stats the histograms result
+ * @param reset RT_TRUE to clear the histograms after reading
+ */
+rt_err_t x9555_latency_get(x9555_device_t device, struct x9555_latency_stats *stats, rt_bool_t reset)
+{
+    RT_ASSERT(device);
+    RT_ASSERT(stats);
+
+    x9555_lock_take(device);
+    *stats = device->latency;
+    if (reset)
+    {
+        rt_memset(&device->latency, 0, sizeof(struct x9555_latency_stats));
+    }
+    rt_mutex_release(&device->lock);
+
+    return RT_EOK;
+}
+#endif /* PKG_USING_X9555_LATENCY */
+
+/* the worker arms the interrupt again after serving it, unless the device is being torn down */
+rt_inline void x9555_irq_rearm(x9555_device_t device)
+{
+    if (!device->irq_closing)
+    {
+        rt_pin_irq_enable(device->device_interrupt_pin, PIN_IRQ_ENABLE);
+    }
+}
+
+/* must come before the worker stops, afterwards no interrupt can notify it any more */
+static void x9555_irq_release(x9555_device_t device)
+{
+    if (device->device_interrupt_pin > -1)
+    {
+        device->irq_closing = RT_TRUE;
+        rt_pin_irq_enable(device->device_interrupt_pin, PIN_IRQ_DISABLE);
+        rt_pin_detach_irq(device->device_interrupt_pin);
+    }
+}
+
+#ifdef PKG_USING_X9555_IRQ_STORM
+/* the rate is measured over 100 ms windows so a storm is caught before it starves the system for long */
+#define X9555_STORM_WINDOW          ((RT_TICK_PER_SECOND / 10) ? (RT_TICK_PER_SECOND / 10) : 1)
+#define X9555_STORM_WINDOW_IRQS     (((rt_uint32_t)PKG_X9555_IRQ_RATE_MAX * X9555_STORM_WINDOW / RT_TICK_PER_SECOND) ? \
+                                     ((rt_uint32_t)PKG_X9555_IRQ_RATE_MAX * X9555_STORM_WINDOW / RT_TICK_PER_SECOND) : 1)
+
+/* called by the worker for every interrupt it served, returns RT_TRUE when the interrupt must stay off */
+static rt_bool_t x9555_storm_irq(x9555_device_t device)
+{
+    rt_tick_t now = rt_tick_get();
+
+    if (now - device->storm_window_start >= X9555_STORM_WINDOW)
+    {
+        device->storm_window_start = now;
+        device->storm_irqs = 0;
+    }
+
+    if (++device->storm_irqs <= X9555_STORM_WINDOW_IRQS)
+    {
+        return RT_FALSE;
+    }
+
+    device->storm.polling = RT_TRUE;
+    device->storm.to_polling++;
+    device->storm_poll_tick = now;
+    device->storm_quiet_start = now;
+    LOG_W("The x9555 0x%02x interrupt storm, more than %d interrupts per second. Polling the inputs.",
+          device->device_address, PKG_X9555_IRQ_RATE_MAX);
+
+    return RT_TRUE;
+}
+
+/* input poll while the interrupt is off, arms it again once INT stayed released and the inputs still */
+static void x9555_storm_poll(x9555_device_t device)
+{
+    rt_tick_t now = rt_tick_get();
+    rt_uint16_t old_value;
+
+    if (now - device->storm_poll_tick < rt_tick_from_millisecond(PKG_X9555_STORM_POLL_MS))
+    {
+        return;
+    }
+    device->storm_poll_tick = now;
+
+    old_value = device->input_state;
+    x9555_input_service(device, now);
+    device->storm.polls++;
+
+    if (device->input_state != old_value)
+    {
+        /* the interrupt is off, so the callback is called from here instead */
+        device->storm_quiet_start = now;
+        call_input_interrupt(device);
+        return;
+    }
+
+    /* the read above released INT, asserted again without an input change means a stuck line */
+    if (rt_pin_read(device->device_interrupt_pin) == PIN_LOW)
+    {
+        device->storm_quiet_start = now;
+        return;
+    }
+
+    if (now - device->storm_quiet_start >= rt_tick_from_millisecond(PKG_X9555_STORM_QUIET_MS))
+    {
+        device->storm.polling = RT_FALSE;
+        device->storm.to_interrupt++;
+        device->storm_window_start = now;
+        device->storm_irqs = 0;
+        LOG_I("The x9555 0x%02x interrupt line is quiet again.", device->device_address);
+        x9555_irq_rearm(device);
+    }
+}
+
+/**
+ * This function gets the interrupt storm counters, every switch between interrupt and polling
+ * is counted, so a line which keeps switching points at bad wiring or a chattering input.
+ *
+ * @param device the pointer of device driver structure
+ * @param stats the counters
+ * @param reset clear the counters after reading them
+ */
+rt_err_t x9555_storm_stats_get(x9555_device_t device, struct x9555_storm_stats *stats, rt_bool_t reset)
+{
+    RT_ASSERT(device);
+    RT_ASSERT(stats);
+
+    x9555_lock_take(device);
+    *stats = device->storm;
+    if (reset)
+    {
+        device->storm.to_polling = 0;
+        device->storm.to_interrupt = 0;
+        device->storm.polls = 0;
+    }
+    rt_mutex_release(&device->lock);
+
+    return RT_EOK;
+}
+#endif /* PKG_USING_X9555_IRQ_STORM */
+
+static void x9555_interrupt_handler(void *args)
+{
+    x9555_device_t device = (x9555_device_t)args;
+
+#ifdef PKG_USING_X9555_LATENCY
+    device->irq_timestamp = x9555_timestamp_get();
+#endif
+
+    /* INT stays asserted until the inputs are read over I2C, keep it masked for the worker */
+    rt_pin_irq_enable(device->device_interrupt_pin, PIN_IRQ_DISABLE);
+
+    device->irq_tick = rt_tick_get();
+    x9555_worker_notify(device, X9555_EVENT_IRQ);
+}
+
+static rt_int32_t x9555_worker_timeout(x9555_device_t device)
+{
+#ifdef PKG_USING_X9555_IRQ_STORM
+    rt_int32_t timeout;
+
+    if (device->storm.polling)
+    {
+        timeout = rt_tick_from_millisecond(PKG_X9555_STORM_POLL_MS);
+        return (timeout > 0) ? timeout : 1;
+    }
+#endif
+    return device->poll_period;
+}
+
+/* serves the events flagged for a device, timeout is set when its poll period expired */
+static void x9555_worker_service(x9555_device_t device, rt_uint32_t recved, rt_bool_t timeout)
+{
+#ifdef PKG_USING_X9555_LATENCY
+    rt_uint32_t wakeup, dispatch;
+#endif
+
+#ifdef PKG_USING_X9555_ISR_API
+    if (recved & X9555_EVENT_OUTPUT)
+    {
+        x9555_isr_output_service(device);
+    }
+#endif
+
+#ifdef PKG_USING_X9555_SOFT_PWM
+    if (recved & X9555_EVENT_PWM)
+    {
+        x9555_pwm_service(device);
+    }
+#endif
+
+#ifdef PKG_USING_X9555_WRITE_BACK
+    if (recved & X9555_EVENT_FLUSH)
+    {
+        x9555_lock_take(device);
+        if (device->write_back)
+        {
+            x9555_write_back_flush(device);
+        }
+        rt_mutex_release(&device->lock);
+    }
+#endif
+
+    if (recved & X9555_EVENT_IRQ)
+    {
+#ifdef PKG_USING_X9555_LATENCY
+        wakeup = x9555_timestamp_get();
+        x9555_input_service(device, device->irq_tick);
+        dispatch = x9555_timestamp_get();
+        call_input_interrupt(device);
+        x9555_latency_update(device, wakeup, dispatch);
+#else
+        x9555_input_service(device, device->irq_tick);
+        call_input_interrupt(device);
+#endif
+#ifdef PKG_USING_X9555_IRQ_STORM
+        if (!x9555_storm_irq(device))
+        {
+            x9555_irq_rearm(device);
+        }
+#else
+        x9555_irq_rearm(device);
+#endif
+    }
+#ifdef PKG_USING_X9555_IRQ_STORM
+    else if (device->storm.polling)
+    {
+        /* due on its own schedule, whatever other events wake the worker */
+        x9555_storm_poll(device);
+    }
+#endif
+    else if (timeout)
+    {
+        x9555_input_service(device, rt_tick_get());
+    }
+
+#ifdef PKG_USING_X9555_PIN_OPS
+    /* whatever path saw the input change, its pin handlers run here */
+    x9555_pin_ops_fire(device);
+#endif
+
+#ifdef PKG_USING_X9555_SCRUBBER
+    /* lowest priority work, after input and PWM have been served */
+    if (recved & X9555_EVENT_SCRUB)
+    {
+        x9555_scrub_service(device);
+    }
+#endif
+}
+
+#ifndef X9555_USING_WORKER_POOL
+static rt_err_t x9555_worker_notify(x9555_device_t device, rt_uint32_t flags)
+{
+    return rt_event_send(device->event, flags);
+}
+
+static void x9555_worker_entry(void *parameter)
+{
+    x9555_device_t device = (x9555_device_t)parameter;
+    rt_uint32_t recved;
+    rt_err_t result;
+
+    while (1)
+    {
+        recved = 0;
+        result = rt_event_recv(device->event, X9555_EVENT_IRQ | X9555_EVENT_WAKE | X9555_EVENT_EXIT | X9555_EVENT_PWM |
+                               X9555_EVENT_SCRUB | X9555_EVENT_FLUSH | X9555_EVENT_OUTPUT, RT_EVENT_FLAG_OR | RT_EVENT_FLAG_CLEAR,
+                               x9555_worker_timeout(device), &recved);
+
+        if (recved & X9555_EVENT_EXIT)
+        {
+            break;
+        }
+
+        x9555_worker_service(device, recved, result == -RT_ETIMEOUT);
+    }
+
+    rt_event_send(device->event, X9555_EVENT_EXITED);
+}
+
+static rt_err_t x9555_worker_start(x9555_device_t device)
+{
+    device->event = rt_event_create("event_x9555", RT_IPC_FLAG_FIFO);
+    if (device->event == RT_NULL)
+    {
+        return -RT_ENOMEM;
+    }
+
+    device->worker = rt_thread_create("x9555", x9555_worker_entry, device,
+                                      PKG_X9555_THREAD_STACK_SIZE, PKG_X9555_THREAD_PRIORITY, 10);
+    if (device->worker == RT_NULL)
+    {
+        rt_event_delete(device->event);
+        return -RT_ENOMEM;
+    }
+#ifdef PKG_USING_X9555_BUS_CPU
+    /* the bottom half runs on the core that owns the bus */
+    x9555_bus_cpu_bind(device->worker, device->bus->cpu);
+#endif
+    rt_thread_startup(device->worker);
+
+    return RT_EOK;
+}
+
+static void x9555_worker_stop(x9555_device_t device)
+{
+    rt_uint32_t recved;
+
+    rt_event_send(device->event, X9555_EVENT_EXIT);
+    rt_event_recv(device->event, X9555_EVENT_EXITED, RT_EVENT_FLAG_OR | RT_EVENT_FLAG_CLEAR,
+                  RT_WAITING_FOREVER, &recved);
+    rt_event_delete(device->event);
+}
+#else
+/*
+ * Shared worker pool: every device flags its events into device->pending and is queued on the
+ * run queue of its bus, a worker thread drains the run queues of the buses it serves. Buses are
+ * spread over PKG_X9555_WORKER_NUM workers, or each bus gets a worker of its own when it is 0.
+ */
+struct x9555_worker
+{
+    rt_thread_t thread;
+    struct rt_event event;
+    struct rt_mutex lock;     // guards the bus and device lists, not held while a batch is served
+    rt_list_t buses;
+    rt_uint16_t bus_count;
+    rt_bool_t serving;        // a batch taken off the lists is being served, guarded by lock
+    rt_bool_t stopping;       // x9555_worker_stop() waits for the batch, guarded by lock
+#ifdef PKG_USING_X9555_BUS_CPU
+    rt_uint8_t cpu;
+#endif
+};
 
-                result = x9555_write_one_byte(device, X9555_Register_Polarity_Inversion_Port_0, send_register_value);
-            }
-            else if (port == X9555_PORT_1)
-            {
-                result = x9555_read_one_byte(device, X9555_Register_Configuration_Port_1, read_value_buff);
+/* one device to serve, taken off the lists under worker->lock */
+struct x9555_pool_job
+{
+    x9555_device_t device;
+    rt_uint32_t pending;
+    rt_bool_t timeout;
+};
 
-                send_register_value = *read_value_buff | (1 << (pin % 10));
+#define X9555_POOL_BATCH        8
+#define X9555_EVENT_SERVED      (1 << 8) // worker event, the batch x9555_worker_stop() waited for is done
 
-                result = x9555_write_one_byte(device, X9555_Register_Configuration_Port_1, send_register_value);
+#if PKG_X9555_WORKER_NUM > 0
+static struct x9555_worker x9555_workers[PKG_X9555_WORKER_NUM];
+#endif
+static struct rt_mutex x9555_pool_lock; // serializes attaching and detaching buses
 
-                result = x9555_read_one_byte(device, X9555_Register_Polarity_Inversion_Port_1, read_value_buff);
+static int x9555_pool_init(void)
+{
+    return rt_mutex_init(&x9555_pool_lock, "x9555p", RT_IPC_FLAG_PRIO);
+}
+INIT_PREV_EXPORT(x9555_pool_init);
 
-                send_register_value = *read_value_buff | (1 << (pin % 10));
+/* may be called from interrupt context, a device is queued once until the worker takes its events */
+static rt_err_t x9555_worker_notify(x9555_device_t device, rt_uint32_t flags)
+{
+    struct x9555_bus *bus = device->bus;
+    rt_bool_t queued;
+    rt_base_t level;
 
-                result = x9555_write_one_byte(device, X9555_Register_Polarity_Inversion_Port_1, send_register_value);
-            }
-        }
-    }
-    else
+    level = rt_spin_lock_irqsave(&bus->run_lock);
+    queued = (device->pending != 0);
+    if (!queued)
     {
-        LOG_E("The x9555 could not respond  at this time. Please try again.");
-        result = -RT_ERROR;
+        rt_list_insert_before(&bus->run_queue, &device->run_node);
     }
+    device->pending |= flags;
+    rt_spin_unlock_irqrestore(&bus->run_lock, level);
 
-    rt_mutex_release(device->lock);
-    return result;
+    return queued ? RT_EOK : rt_event_send(&bus->worker->event, X9555_EVENT_WAKE);
 }
 
-rt_err_t x9555_pin_write(x9555_device_t device, rt_uint8_t pin, rt_uint8_t pin_state)
+/* must be called with worker->lock held, takes at most one queued device per bus so the buses take turns */
+static rt_uint32_t x9555_pool_take_queued(struct x9555_worker *worker, struct x9555_pool_job *jobs)
 {
-    rt_err_t result = RT_EOK;
-    RT_ASSERT(device);
-
-    result = rt_mutex_take(device->lock, RT_WAITING_FOREVER);
+    struct x9555_bus *bus;
+    x9555_device_t device;
+    rt_uint32_t count = 0;
+    rt_base_t level;
 
-    if (result == RT_EOK)
+    rt_list_for_each_entry(bus, &worker->buses, worker_node)
     {
-        rt_uint8_t port = X9555_PORT_NULL;
-        rt_uint8_t read_value_buff[2] = {'\0'};
-        rt_uint8_t send_pin_state;
-
-        port = x9555_pin_port_switch(pin);
-
-        if (port == X9555_PORT_NULL)
+        if (count == X9555_POOL_BATCH)
         {
-            LOG_E("The x9555 pin don't found. Please try again.");
-
-            rt_mutex_release(device->lock);
-            result = -RT_ERROR;
-            return result;
+            break;
         }
 
-        if ((pin_state != X9555_PIN_HIGH) && (pin_state != X9555_PIN_LOW))
+        level = rt_spin_lock_irqsave(&bus->run_lock);
+        if (!rt_list_isempty(&bus->run_queue))
         {
-            LOG_E("The x9555 pin state don't found. Please try again.");
-
-            rt_mutex_release(device->lock);
-            result = -RT_ERROR;
-            return result;
+            device = rt_list_first_entry(&bus->run_queue, struct x9555_device, run_node);
+            rt_list_remove(&device->run_node);
+            jobs[count].device = device;
+            jobs[count].pending = device->pending;
+            jobs[count].timeout = RT_FALSE;
+            device->pending = 0;
+            count++;
         }
+        rt_spin_unlock_irqrestore(&bus->run_lock, level);
+    }
 
-        if (port == X9555_PORT_0)
-        {
-            result = x9555_read_one_byte(device, X9555_Register_Output_Port_0, read_value_buff);
+    return count;
+}
 
-            if (pin_state == X9555_PIN_HIGH)
-            {
-                send_pin_state = *read_value_buff | (1 << pin);
-            }
-            else if (pin_state == X9555_PIN_LOW)
+/* must be called with worker->lock held, takes the devices whose poll period expired and gets the next timeout */
+static rt_uint32_t x9555_pool_take_due(struct x9555_worker *worker, struct x9555_pool_job *jobs, rt_int32_t *timeout)
+{
+    struct x9555_bus *bus;
+    x9555_device_t device;
+    rt_int32_t period, remain;
+    rt_uint32_t count = 0;
+    rt_tick_t now = rt_tick_get();
+
+    *timeout = RT_WAITING_FOREVER;
+    rt_list_for_each_entry(bus, &worker->buses, worker_node)
+    {
+        rt_list_for_each_entry(device, &bus->devices, node)
+        {
+            period = x9555_worker_timeout(device);
+            if (period == RT_WAITING_FOREVER)
             {
-                send_pin_state = (*read_value_buff) & (~(1 << pin));
+                continue;
             }
-            result = x9555_write_one_byte(device, X9555_Register_Output_Port_0, send_pin_state);
-        }
-        else if (port == X9555_PORT_1)
-        {
-            result = x9555_read_one_byte(device, X9555_Register_Output_Port_1, read_value_buff);
 
-            if (pin_state == X9555_PIN_HIGH)
+            remain = period - (rt_int32_t)(now - device->poll_tick);
+            if ((remain <= 0) && (count < X9555_POOL_BATCH))
             {
-                send_pin_state = *read_value_buff | (1 << (pin % 10));
+                device->poll_tick = now;
+                jobs[count].device = device;
+                jobs[count].pending = 0;
+                jobs[count].timeout = RT_TRUE;
+                count++;
+                remain = period;
             }
-            else if (pin_state == X9555_PIN_LOW)
+            if ((*timeout == RT_WAITING_FOREVER) || (remain < *timeout))
             {
-                send_pin_state = (*read_value_buff) & (~(1 << (pin % 10)));
+                /* a device left for the next batch is due at once */
+                *timeout = (remain > 0) ? remain : 0;
             }
-            result = x9555_write_one_byte(device, X9555_Register_Output_Port_1, send_pin_state);
         }
     }
-    else
-    {
-        LOG_E("The x9555 could not respond  at this time. Please try again.");
-        result = -RT_ERROR;
-    }
 
-    rt_mutex_release(device->lock);
-    return result;
+    return count;
 }
 
-rt_bool_t x9555_pin_read(x9555_device_t device, rt_uint8_t pin, rt_uint8_t pin_mode)
+/*
+ * Must be called with worker->lock held. The jobs are served without it, so callbacks do not hold
+ * off x9555_init() and x9555_deinit() of other devices, x9555_worker_stop() waits for the batch instead.
+ */
+static void x9555_pool_serve(struct x9555_worker *worker, struct x9555_pool_job *jobs, rt_uint32_t count)
 {
-    rt_err_t result = RT_EOK;
-    RT_ASSERT(device);
+    rt_uint32_t i;
 
-    rt_bool_t read_state = X9555_PIN_NULL;
-    rt_uint8_t port = X9555_PORT_NULL;
-    rt_uint8_t read_value_buff[2] = {'\0'};
+    worker->serving = RT_TRUE;
+    rt_mutex_release(&worker->lock);
 
-    result = rt_mutex_take(device->lock, RT_WAITING_FOREVER);
+    for (i = 0; i < count; i++)
+    {
+        x9555_worker_service(jobs[i].device, jobs[i].pending, jobs[i].timeout);
+    }
 
-    if (result == RT_EOK)
+    rt_mutex_take(&worker->lock, RT_WAITING_FOREVER);
+    worker->serving = RT_FALSE;
+    if (worker->stopping)
     {
-        port = x9555_pin_port_switch(pin);
+        worker->stopping = RT_FALSE;
+        rt_event_send(&worker->event, X9555_EVENT_SERVED);
+    }
+}
 
-        if (port == X9555_PORT_NULL)
-        {
-            LOG_E("The x9555 pin don't found. Please try again.");
+static void x9555_pool_entry(void *parameter)
+{
+    struct x9555_worker *worker = (struct x9555_worker *)parameter;
+    struct x9555_pool_job jobs[X9555_POOL_BATCH];
+    rt_int32_t timeout = RT_WAITING_FOREVER;
+    rt_uint32_t recved, count;
 
-            rt_mutex_release(device->lock);
-            result = -RT_ERROR;
-            return result;
-        }
+    while (1)
+    {
+        recved = 0;
+        rt_event_recv(&worker->event, X9555_EVENT_WAKE | X9555_EVENT_EXIT, RT_EVENT_FLAG_OR | RT_EVENT_FLAG_CLEAR,
+                      timeout, &recved);
 
-        if ((pin_mode != X9555_PIN_HIGH) && (pin_mode != X9555_PIN_LOW))
+        if (recved & X9555_EVENT_EXIT)
         {
-            LOG_E("The x9555 pin state don't found. Please try again.");
+            break;
+        }
 
-            rt_mutex_release(device->lock);
-            result = -RT_ERROR;
-            return result;
+        rt_mutex_take(&worker->lock, RT_WAITING_FOREVER);
+
+        while ((count = x9555_pool_take_queued(worker, jobs)) > 0)
+        {
+            x9555_pool_serve(worker, jobs, count);
         }
 
-        if (pin_mode == X9555_INPUT)
+        /* expired poll periods, then sleep until the next one */
+        while ((count = x9555_pool_take_due(worker, jobs, &timeout)) > 0)
         {
-            if (port == X9555_PORT_0)
-            {
-                result = x9555_read_one_byte(device, X9555_Register_Input_Port_0, read_value_buff);
-            }
-            else if (port == X9555_PORT_1)
-            {
-                result = x9555_read_one_byte(device, X9555_Register_Input_Port_1, read_value_buff);
-            }
+            x9555_pool_serve(worker, jobs, count);
         }
-        else if (pin_mode == X9555_OUTPUT)
+
+        rt_mutex_release(&worker->lock);
+    }
+
+    rt_event_send(&worker->event, X9555_EVENT_EXITED);
+}
+
+/* must be called with x9555_pool_lock held */
+static struct x9555_worker *x9555_pool_worker_get(struct x9555_bus *bus)
+{
+    struct x9555_worker *worker;
+    char name[RT_NAME_MAX];
+    static rt_uint16_t index = 0;
+#if PKG_X9555_WORKER_NUM > 0
+    int i;
+
+    /* the least loaded worker takes the new bus */
+    worker = &x9555_workers[0];
+    for (i = 1; i < PKG_X9555_WORKER_NUM; i++)
+    {
+        if (x9555_workers[i].bus_count < worker->bus_count)
         {
-            if (port == X9555_PORT_0)
-            {
-                result = x9555_read_one_byte(device, X9555_Register_Output_Port_0, read_value_buff);
-            }
-            else if (port == X9555_PORT_1)
-            {
-                result = x9555_read_one_byte(device, X9555_Register_Output_Port_1, read_value_buff);
-            }
+            worker = &x9555_workers[i];
         }
-        else if (pin_mode == X9555_POLARITY_INVERSION)
+    }
+#ifdef PKG_USING_X9555_BUS_CPU
+    /* worker i stays on core i % X9555_CPUS_NR, prefer the least loaded one on the core of the bus */
+    for (i = bus->cpu; (bus->cpu != X9555_CPU_ANY) && (i < PKG_X9555_WORKER_NUM); i += X9555_CPUS_NR)
+    {
+        if (((worker - x9555_workers) % X9555_CPUS_NR != bus->cpu) || (x9555_workers[i].bus_count < worker->bus_count))
         {
-            if (port == X9555_PORT_0)
-            {
-                result = x9555_read_one_byte(device, X9555_Register_Polarity_Inversion_Port_0, read_value_buff);
-            }
-            else if (port == X9555_PORT_1)
-            {
-                result = x9555_read_one_byte(device, X9555_Register_Polarity_Inversion_Port_0, read_value_buff);
-            }
+            worker = &x9555_workers[i];
         }
+    }
+    worker->cpu = (worker - x9555_workers) % X9555_CPUS_NR;
+#endif
+    if (worker->thread != RT_NULL)
+    {
+        return worker;
+    }
+#else
+    worker = rt_calloc(1, sizeof(struct x9555_worker));
+    if (worker == RT_NULL)
+    {
+        return RT_NULL;
+    }
+#endif
 
-        if (result == RT_EOK)
+    rt_snprintf(name, sizeof(name), "x9555%d", index++ % 100);
+    rt_event_init(&worker->event, name, RT_IPC_FLAG_FIFO);
+    rt_mutex_init(&worker->lock, name, RT_IPC_FLAG_PRIO);
+    rt_list_init(&worker->buses);
+    worker->thread = rt_thread_create(name, x9555_pool_entry, worker,
+                                      PKG_X9555_THREAD_STACK_SIZE, PKG_X9555_THREAD_PRIORITY, 10);
+    if (worker->thread == RT_NULL)
+    {
+        rt_mutex_detach(&worker->lock);
+        rt_event_detach(&worker->event);
+#if PKG_X9555_WORKER_NUM == 0
+        rt_free(worker);
+#endif
+        return RT_NULL;
+    }
+#ifdef PKG_USING_X9555_BUS_CPU
+#if PKG_X9555_WORKER_NUM == 0
+    worker->cpu = bus->cpu;
+#endif
+    x9555_bus_cpu_bind(worker->thread, worker->cpu);
+#endif
+    rt_thread_startup(worker->thread);
+
+    return worker;
+}
+
+/* must be called with x9555_pool_lock held */
+static void x9555_pool_worker_put(struct x9555_worker *worker)
+{
+    rt_uint32_t recved;
+
+    if (worker->bus_count > 0)
+    {
+        return;
+    }
+
+    rt_event_send(&worker->event, X9555_EVENT_EXIT);
+    rt_event_recv(&worker->event, X9555_EVENT_EXITED, RT_EVENT_FLAG_OR | RT_EVENT_FLAG_CLEAR,
+                  RT_WAITING_FOREVER, &recved);
+    worker->thread = RT_NULL;
+    rt_mutex_detach(&worker->lock);
+    rt_event_detach(&worker->event);
+#if PKG_X9555_WORKER_NUM == 0
+    rt_free(worker);
+#endif
+}
+
+static rt_err_t x9555_worker_start(x9555_device_t device)
+{
+    struct x9555_bus *bus = device->bus;
+    struct x9555_worker *worker;
+
+    rt_mutex_take(&x9555_pool_lock, RT_WAITING_FOREVER);
+
+    worker = bus->worker;
+    if (worker == RT_NULL)
+    {
+        worker = x9555_pool_worker_get(bus);
+        if (worker == RT_NULL)
         {
-            if (port == X9555_PORT_0)
-            {
-                read_state = (*read_value_buff & (1 << pin)) > 0 ? X9555_PIN_HIGH : X9555_PIN_LOW;
-            }
-            else if (port == X9555_PORT_1)
-            {
-                read_state = (*read_value_buff & (1 << (pin % 10))) > 0 ? X9555_PIN_HIGH : X9555_PIN_LOW;
-            }
+            rt_mutex_release(&x9555_pool_lock);
+            return -RT_ENOMEM;
         }
     }
+
+    rt_list_init(&device->run_node);
+    device->poll_tick = rt_tick_get();
+
+    rt_mutex_take(&worker->lock, RT_WAITING_FOREVER);
+    if (bus->worker == RT_NULL)
+    {
+        bus->worker = worker;
+        worker->bus_count++;
+        rt_list_insert_before(&worker->buses, &bus->worker_node);
+    }
+    rt_list_insert_before(&bus->devices, &device->node);
+    rt_mutex_release(&worker->lock);
+
+    rt_mutex_release(&x9555_pool_lock);
+
+    return RT_EOK;
+}
+
+static void x9555_worker_stop(x9555_device_t device)
+{
+    struct x9555_bus *bus = device->bus;
+    struct x9555_worker *worker = bus->worker;
+    rt_uint32_t recved;
+    rt_base_t level;
+
+    /* a callback can not deinit a device, the worker would wait for itself */
+    RT_ASSERT(rt_thread_self() != worker->thread);
+
+    rt_mutex_take(&x9555_pool_lock, RT_WAITING_FOREVER);
+
+    rt_mutex_take(&worker->lock, RT_WAITING_FOREVER);
+    rt_list_remove(&device->node);
+
+    /* a non-zero pending set keeps late notifications off the run queue */
+    level = rt_spin_lock_irqsave(&bus->run_lock);
+    rt_list_remove(&device->run_node);
+    device->pending = X9555_EVENT_EXIT;
+    rt_spin_unlock_irqrestore(&bus->run_lock, level);
+
+    if (rt_list_isempty(&bus->devices))
+    {
+        rt_list_remove(&bus->worker_node);
+        bus->worker = RT_NULL;
+        worker->bus_count--;
+    }
+
+    /* off the lists no new batch takes the device, the one being served may still hold it */
+    if (worker->serving)
+    {
+        worker->stopping = RT_TRUE;
+        rt_mutex_release(&worker->lock);
+        rt_event_recv(&worker->event, X9555_EVENT_SERVED, RT_EVENT_FLAG_OR | RT_EVENT_FLAG_CLEAR,
+                      RT_WAITING_FOREVER, &recved);
+    }
     else
     {
-        LOG_E("The x9555 could not respond  at this time. Please try again.");
-        result = -RT_ERROR;
+        rt_mutex_release(&worker->lock);
     }
 
-    rt_mutex_release(device->lock);
-    return read_state;
+    x9555_pool_worker_put(worker);
+
+    rt_mutex_release(&x9555_pool_lock);
 }
+#endif /* X9555_USING_WORKER_POOL */
 
-/****************************************************************************************/
+/**
+ * This function prints the object sizes of the memory table in the README for the running
+ * configuration, "x9555 footprint" in the example.
+ */
+void x9555_footprint(void)
+{
+    rt_kprintf("struct x9555_device : %d\n", (int)sizeof(struct x9555_device));
+    rt_kprintf("struct x9555_bus    : %d\n", (int)sizeof(struct x9555_bus));
+#ifdef X9555_USING_WORKER_POOL
+    rt_kprintf("struct x9555_worker : %d, one per bus or PKG_X9555_WORKER_NUM\n", (int)sizeof(struct x9555_worker));
+#else
+    rt_kprintf("struct rt_event     : %d, one per device\n", (int)sizeof(struct rt_event));
+#endif
+    rt_kprintf("struct rt_thread    : %d\n", (int)sizeof(struct rt_thread));
+    rt_kprintf("worker stack        : %d\n", PKG_X9555_THREAD_STACK_SIZE);
+}
 
-__attribute__((weak)) void call_input_interrupt(void *args)
+/**
+ * This function sets the input poll period of the worker thread,
+ * for devices without interrupt pin or to back up the interrupt.
+ *
+ * @param device the pointer of device driver structure
+ * @param period_ms the poll period, 0 disables polling
+ */
+rt_err_t x9555_poll_period_set(x9555_device_t device, rt_uint32_t period_ms)
 {
-    rt_kprintf("Complete your own interrupt service program in the other file.\n");
+    RT_ASSERT(device);
+
+    if (period_ms == 0)
+    {
+        device->poll_period = RT_WAITING_FOREVER;
+    }
+    else
+    {
+        device->poll_period = rt_tick_from_millisecond(period_ms);
+        if (device->poll_period == 0)
+        {
+            device->poll_period = 1;
+        }
+    }
+
+    return x9555_worker_notify(device, X9555_EVENT_WAKE);
 }
 
 rt_err_t x9555_interrupt_clear(x9555_device_t device, char *interrupt_get_value)
@@ -632,7 +4838,7 @@ rt_err_t x9555_interrupt_clear(x9555_device_t device, char *interrupt_get_value)
     rt_err_t result = RT_EOK;
     RT_ASSERT(device);
 
-    result = rt_mutex_take(device->lock, RT_WAITING_FOREVER);
+    result = x9555_lock_take(device);
 
     rt_uint8_t read_value_buff[2] = {'\0'};
 
@@ -641,8 +4847,14 @@ rt_err_t x9555_interrupt_clear(x9555_device_t device, char *interrupt_get_value)
         result = x9555_read_one_byte(device, X9555_Register_Input_Port_0, read_value_buff);
         interrupt_get_value[0] = *read_value_buff;
 
-        result &= x9555_read_one_byte(device, X9555_Register_Input_Port_1, read_value_buff);
+        result |= x9555_read_one_byte(device, X9555_Register_Input_Port_1, read_value_buff);
         interrupt_get_value[1] = *read_value_buff;
+
+        if (result == RT_EOK)
+        {
+            x9555_input_update(device, (rt_uint8_t)interrupt_get_value[0] | ((rt_uint8_t)interrupt_get_value[1] << 8),
+                               rt_tick_get());
+        }
     }
     else
     {
@@ -655,7 +4867,7 @@ rt_err_t x9555_interrupt_clear(x9555_device_t device, char *interrupt_get_value)
         rt_memset(interrupt_get_value, '\0', sizeof(interrupt_get_value));
     }
 
-    rt_mutex_release(device->lock);
+    rt_mutex_release(&device->lock);
 
     return result;
 }
@@ -664,6 +4876,7 @@ x9555_device_t x9555_init(const char *interrupt_pin_name, const char *i2c_bus_na
 {
     x9555_device_t device;
     rt_err_t result = RT_EOK;
+    rt_uint8_t read_value_buff[8] = {'\0'};
 
     RT_ASSERT(i2c_bus_name);
 
@@ -674,6 +4887,8 @@ x9555_device_t x9555_init(const char *interrupt_pin_name, const char *i2c_bus_na
         return RT_NULL;
     }
 
+    x9555_timestamp_init();
+
     device->i2c = rt_i2c_bus_device_find(i2c_bus_name);
     if (device->i2c == RT_NULL)
     {
@@ -682,22 +4897,93 @@ x9555_device_t x9555_init(const char *interrupt_pin_name, const char *i2c_bus_na
         return RT_NULL;
     }
 
-    device->lock = rt_mutex_create("mutex_x9555", RT_IPC_FLAG_FIFO);
-    if (device->lock == RT_NULL)
+    device->bus = x9555_bus_get(device->i2c);
+    if (device->bus == RT_NULL)
+    {
+        LOG_E("Can't allocate memory for x9555 bus '%s' .", i2c_bus_name);
+        rt_free(device);
+        return RT_NULL;
+    }
+
+    if (x9555_lock_create(device) != RT_EOK)
     {
         LOG_E("Can't create mutex for x9555 device on '%s' .", i2c_bus_name);
+        x9555_bus_put(device->bus);
         rt_free(device);
         return RT_NULL;
     }
 
     device->device_address = X9555_ADDR | device_user_input_address;
+    device->device_interrupt_pin = -1;
+    device->poll_period = RT_WAITING_FOREVER;
+#ifdef PKG_USING_X9555_PIN_WAIT
+    rt_list_init(&device->pin_waiters);
+#endif
+#ifdef PKG_USING_X9555_EVENT_RING
+    rt_completion_init(&device->ring.ready);
+#endif
+
+    /* power-on defaults, used as is if the chip does not answer yet */
+    device->output_state = 0xffff;
+    device->polarity_state = 0x0000;
+    device->config_state = 0xffff;
+
+    /* take the first input snapshot and register shadow, later changes are made against them */
+    if ((x9555_read_bytes(device, X9555_Register_Input_Port_0, read_value_buff, 2, X9555_PRIO_NORMAL) == RT_EOK) &&
+        (x9555_read_bytes(device, X9555_Register_Output_Port_0, &read_value_buff[2], 2, X9555_PRIO_NORMAL) == RT_EOK) &&
+        (x9555_read_bytes(device, X9555_Register_Polarity_Inversion_Port_0, &read_value_buff[4], 2, X9555_PRIO_NORMAL) == RT_EOK) &&
+        (x9555_read_bytes(device, X9555_Register_Configuration_Port_0, &read_value_buff[6], 2, X9555_PRIO_NORMAL) == RT_EOK))
+    {
+        device->input_state = read_value_buff[0] | (read_value_buff[1] << 8);
+#ifdef PKG_USING_X9555_PIN_OPS
+        device->input_valid = RT_TRUE;
+#endif
+        device->output_state = read_value_buff[2] | (read_value_buff[3] << 8);
+        device->polarity_state = read_value_buff[4] | (read_value_buff[5] << 8);
+        device->config_state = read_value_buff[6] | (read_value_buff[7] << 8);
+    }
+    else
+    {
+        LOG_W("x9555 device 0x%02x on '%s' does not respond.", device->device_address, i2c_bus_name);
+    }
+
+#ifdef PKG_USING_X9555_DEVICE
+    /* registered before anything can report an input change */
+    if (x9555_device_register(device) != RT_EOK)
+    {
+        x9555_lock_delete(device);
+        x9555_bus_put(device->bus);
+        rt_free(device);
+        return RT_NULL;
+    }
+#endif
+
+    if (x9555_worker_start(device) != RT_EOK)
+    {
+        LOG_E("Can't create worker for x9555 device on '%s' .", i2c_bus_name);
+#ifdef PKG_USING_X9555_DEVICE
+        rt_device_unregister(&device->parent);
+#endif
+        x9555_lock_delete(device);
+        x9555_bus_put(device->bus);
+        rt_free(device);
+        return RT_NULL;
+    }
+
+#ifdef PKG_USING_X9555_SCRUBBER
+    rt_timer_init(&device->scrub_timer, "x9555s", x9555_scrub_timeout, device, 1, RT_TIMER_FLAG_PERIODIC);
+    x9555_scrub_budget_set(device, PKG_X9555_SCRUB_BUDGET);
+#endif
+#ifdef PKG_USING_X9555_ISR_API
+    rt_timer_init(&device->isr_retry_timer, "x9555r", x9555_isr_retry_timeout, device, 1, RT_TIMER_FLAG_ONE_SHOT);
+#endif
 
     device->device_interrupt_pin = rt_pin_get(interrupt_pin_name);
 
     if (device->device_interrupt_pin > -1)
     {
         rt_pin_mode(device->device_interrupt_pin, PIN_MODE_INPUT_PULLUP);
-        result = rt_pin_attach_irq(device->device_interrupt_pin, PIN_IRQ_MODE_LOW_LEVEL, call_input_interrupt, RT_NULL);
+        result = rt_pin_attach_irq(device->device_interrupt_pin, PIN_IRQ_MODE_LOW_LEVEL, x9555_interrupt_handler, device);
         result = rt_pin_irq_enable(device->device_interrupt_pin, PIN_IRQ_ENABLE);
     }
     else if (strcmp(interrupt_pin_name, "RT_NULL"))
@@ -709,14 +4995,35 @@ x9555_device_t x9555_init(const char *interrupt_pin_name, const char *i2c_bus_na
     if (result != RT_EOK)
     {
         LOG_E("create device '%s' interrupt fail.", interrupt_pin_name);
+        x9555_irq_release(device);
+#ifdef PKG_USING_X9555_SCRUBBER
+        rt_timer_detach(&device->scrub_timer);
+#endif
+#ifdef PKG_USING_X9555_ISR_API
+        rt_timer_detach(&device->isr_retry_timer);
+#endif
+        x9555_worker_stop(device);
+#ifdef PKG_USING_X9555_DEVICE
+        rt_device_unregister(&device->parent);
+#endif
+        x9555_lock_delete(device);
+        x9555_bus_put(device->bus);
         rt_free(device);
         return RT_NULL;
     }
+
+#ifdef PKG_USING_X9555_PIN_OPS
+    /* last, rt_pin_read() serves the input snapshot once the interrupt pin is known */
+    if (x9555_pin_ops_attach(device) != RT_EOK)
+    {
+        LOG_W("x9555 device 0x%02x on '%s' got no rt pin numbers.", device->device_address, i2c_bus_name);
+    }
+#endif
     return device;
 }
 
 /**
- * This function releases memory and deletes mutex lock
+ * This function stops the worker, releases memory and deletes mutex lock
  *
  * @param device the pointer of device driver structure
  */
@@ -724,7 +5031,49 @@ void x9555_deinit(x9555_device_t device)
 {
     RT_ASSERT(device);
 
-    rt_mutex_delete(device->lock);
+    /* the interrupt goes first, it notifies the worker which is stopped below */
+    x9555_irq_release(device);
+
+#ifdef PKG_USING_X9555_SOFT_PWM
+    /* like x9555_pwm_stop(), a PWM event still queued finds the engine stopped and does not arm the timer */
+    x9555_lock_take(device);
+    if (device->pwm != RT_NULL)
+    {
+        device->pwm->running = RT_FALSE;
+        rt_timer_detach(&device->pwm->timer);
+    }
+    rt_mutex_release(&device->lock);
+#endif
+#ifdef PKG_USING_X9555_SCRUBBER
+    rt_timer_detach(&device->scrub_timer);
+#endif
+#ifdef PKG_USING_X9555_ISR_API
+    rt_timer_detach(&device->isr_retry_timer);
+#endif
+#ifdef PKG_USING_X9555_WRITE_BACK
+    /* what is held back still goes out before the device is gone */
+    x9555_write_back_set(device, 0);
+#endif
+
+    x9555_worker_stop(device);
+#ifdef PKG_USING_X9555_PIN_OPS
+    x9555_pin_ops_detach(device);
+#endif
+#ifdef PKG_USING_X9555_SOFT_PWM
+    if (device->pwm != RT_NULL)
+    {
+        rt_free(device->pwm);
+    }
+#endif
+#ifdef PKG_USING_X9555_EDGE_COUNTER
+    rt_free(device->edge);
+#endif
+
+#ifdef PKG_USING_X9555_DEVICE
+    rt_device_unregister(&device->parent);
+#endif
+    x9555_lock_delete(device);
+    x9555_bus_put(device->bus);
 
     rt_free(device);
 }
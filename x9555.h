@@ -7,6 +7,26 @@
  * Date           Author       Notes
  * 2023-10-01     WennianYan   the first version.
  * 2023-10-23     WennianYan   Update the package framework.
+ * 2026-10-19     WennianYan   Add interrupt bottom half and input event ring.
+ * 2026-10-19     WennianYan   Add input edge counters.
+ * 2026-10-19     WennianYan   Add register shadow and soft PWM.
+ * 2026-10-19     WennianYan   Add per-bus transaction combiner.
+ * 2026-10-19     WennianYan   Add bus priority classes and output bursts.
+ * 2026-10-19     WennianYan   Add register scrubber.
+ * 2026-10-19     WennianYan   Add I2C transaction trace.
+ * 2026-10-19     WennianYan   Add device lock statistics.
+ * 2026-10-19     WennianYan   Add blocking pin condition wait.
+ * 2026-10-19     WennianYan   Add pin groups.
+ * 2026-10-19     WennianYan   Add interrupt latency histograms, cycle counter time base.
+ * 2026-10-19     WennianYan   Add write-back mode.
+ * 2026-10-19     WennianYan   Add interrupt-safe pin APIs.
+ * 2026-10-19     WennianYan   Add interrupt storm protection.
+ * 2026-10-19     WennianYan   Add shared worker pool.
+ * 2026-10-19     WennianYan   Add input capture.
+ * 2026-10-19     WennianYan   Add rt_device registration.
+ * 2026-10-19     WennianYan   Add pin framework integration.
+ * 2026-10-19     WennianYan   Add per-bus cpu binding.
+ * 2026-10-19     WennianYan   Add masked mode and 16-bit input read for the C++ layer.
  */
 
 #ifndef __X9555_H__
@@ -26,8 +46,89 @@
 #define DBG_COLOR
 #include <rtdbg.h>
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 #define X9555_ADDR (0x40 >> 1) // A0 A1 A2 connect GND
 
+#ifndef PKG_X9555_THREAD_STACK_SIZE
+#define PKG_X9555_THREAD_STACK_SIZE 1024
+#endif
+
+#ifndef PKG_X9555_THREAD_PRIORITY
+#define PKG_X9555_THREAD_PRIORITY 10
+#endif
+
+#ifndef PKG_X9555_WORKER_NUM
+#define PKG_X9555_WORKER_NUM 0 // shared worker threads, 0 is one per I2C bus
+#endif
+
+/* the shared worker pool is the default, PKG_USING_X9555_WORKER_PER_DEVICE gives each device a thread */
+#ifndef PKG_USING_X9555_WORKER_PER_DEVICE
+#define X9555_USING_WORKER_POOL
+#endif
+
+#ifndef PKG_X9555_EVENT_RING_DEPTH
+#define PKG_X9555_EVENT_RING_DEPTH 32 // must be a power of two
+#endif
+
+#ifndef PKG_X9555_BUS_BATCH_MAX
+#define PKG_X9555_BUS_BATCH_MAX 16 // transfers one thread runs for others before handing over
+#endif
+
+#ifndef PKG_X9555_BUS_CHUNK_SIZE
+#define PKG_X9555_BUS_CHUNK_SIZE 8 // 16-bit values per output burst transaction
+#endif
+
+#ifndef PKG_X9555_SCRUB_BUDGET
+#define PKG_X9555_SCRUB_BUDGET 16 // bus bytes per second spent reading back registers
+#endif
+
+#ifndef PKG_X9555_TRACE_DEPTH
+#define PKG_X9555_TRACE_DEPTH 128 // must be a power of two
+#endif
+
+#ifndef PKG_X9555_CAPTURE_CHUNK
+#define PKG_X9555_CAPTURE_CHUNK 64 // input samples per capture read, 1 ~ 127
+#endif
+
+#ifndef PKG_X9555_LATENCY_BUCKETS
+#define PKG_X9555_LATENCY_BUCKETS 16 // log2 us buckets, the last one holds everything above
+#endif
+
+#ifndef PKG_X9555_IRQ_RATE_MAX
+#define PKG_X9555_IRQ_RATE_MAX 1000 // interrupts per second before falling back to polling
+#endif
+
+#ifndef PKG_X9555_STORM_POLL_MS
+#define PKG_X9555_STORM_POLL_MS 10 // input poll period while the interrupt is off
+#endif
+
+#ifndef PKG_X9555_STORM_QUIET_MS
+#define PKG_X9555_STORM_QUIET_MS 1000 // quiet time before the interrupt is armed again
+#endif
+
+#ifndef PKG_X9555_ISR_RETRY_MS
+#define PKG_X9555_ISR_RETRY_MS 10 // first retry of a failed write from interrupt context, doubled for each next one
+#endif
+
+#ifndef PKG_X9555_BUS_CPU_MAX
+#define PKG_X9555_BUS_CPU_MAX 4 // I2C buses with a core set by x9555_bus_cpu_set()
+#endif
+
+#ifndef PKG_X9555_PIN_BASE
+#define PKG_X9555_PIN_BASE 1000 // first rt pin number of the x9555 pins, above every MCU pin
+#endif
+
+#ifndef PKG_X9555_PIN_DEVICES_MAX
+#define PKG_X9555_PIN_DEVICES_MAX 8 // devices with rt pin numbers, 16 numbers each
+#endif
+
+#ifndef PKG_X9555_EDGE_WINDOW_MS
+#define PKG_X9555_EDGE_WINDOW_MS 1000
+#endif
+
 #define X9555_Register_Input_Port_0                  0x00
 #define X9555_Register_Input_Port_1                  0x01
 #define X9555_Register_Output_Port_0                 0x02
@@ -82,18 +183,351 @@ enum X9555_MODE
     X9555_POLARITY_INVERSION = 0x02
 };
 
+enum X9555_WRITE_ORDER
+{
+    X9555_ORDER_PORT_0_FIRST = 0x00,
+    X9555_ORDER_PORT_1_FIRST = 0x01,
+    X9555_ORDER_CHANGED_ONLY = 0x02
+};
+
+/* bus request classes, a lower value is served first */
+enum X9555_PRIO
+{
+    X9555_PRIO_IRQ = 0x00,
+    X9555_PRIO_NORMAL = 0x01,
+    X9555_PRIO_BULK = 0x02,
+    X9555_PRIO_NUM
+};
+
+enum X9555_LATENCY
+{
+    X9555_LATENCY_WAKEUP = 0x00,   // interrupt -> worker running
+    X9555_LATENCY_READ = 0x01,     // worker running -> input pair read done
+    X9555_LATENCY_DISPATCH = 0x02, // input pair read done -> callback called
+    X9555_LATENCY_TOTAL = 0x03,    // interrupt -> callback called
+    X9555_LATENCY_NUM
+};
+
+/* x9555_bus_cpu_set() and x9555_bus_cpu_get(): the service threads are not bound to a core */
+#define X9555_CPU_ANY 0xff
+
+enum X9555_TRACE_FLAG
+{
+    X9555_TRACE_READ = 0x01,
+    X9555_TRACE_ERROR = 0x02
+};
+
+enum X9555_EDGE
+{
+    X9555_EDGE_NONE = 0x00,
+    X9555_EDGE_RISING = 0x01,
+    X9555_EDGE_FALLING = 0x02,
+    X9555_EDGE_BOTH = 0x03
+};
+
+/*
+ * 16-bit input/output values: bit 0 ~ 7 -> X9555_IO_0_0 ~ X9555_IO_0_7,
+ *                             bit 8 ~ 15 -> X9555_IO_1_0 ~ X9555_IO_1_7.
+ */
+struct x9555_input_event
+{
+    rt_tick_t tick;
+    rt_uint16_t old_value;
+    rt_uint16_t new_value;
+};
+
+#ifdef PKG_USING_X9555_DEVICE
+/* control commands of the "x9555_N" rt_device */
+enum X9555_CTRL
+{
+    X9555_CTRL_PIN_MODE = 0x20,   // struct x9555_ctrl_pin *
+    X9555_CTRL_PORT_MODE = 0x21,  // struct x9555_ctrl_port *
+    X9555_CTRL_BURST = 0x22,      // struct x9555_ctrl_burst *
+    X9555_CTRL_INPUT_READ = 0x23  // rt_uint16_t *, reads the input pair over the bus
+};
+
+/* the element of rt_device_write() */
+struct x9555_output16
+{
+    rt_uint16_t mask;
+    rt_uint16_t value;
+};
+
+struct x9555_ctrl_pin
+{
+    rt_uint8_t pin;
+    rt_uint8_t mode;
+};
+
+struct x9555_ctrl_port
+{
+    rt_uint8_t port;
+    rt_uint8_t mode;
+};
+
+struct x9555_ctrl_burst
+{
+    const rt_uint16_t *values;
+    rt_size_t count;
+};
+#endif
+
+#ifdef PKG_USING_X9555_EVENT_RING
+/* single producer (interrupt/poll bottom half), single consumer */
+struct x9555_event_ring
+{
+    struct x9555_input_event buffer[PKG_X9555_EVENT_RING_DEPTH];
+    rt_atomic_t head;
+    rt_atomic_t tail;
+    rt_atomic_t dropped;
+    struct rt_completion ready;
+};
+#endif
+
+#ifdef PKG_USING_X9555_EDGE_COUNTER
+struct x9555_edge_counter
+{
+    rt_uint16_t rising_mask;
+    rt_uint16_t falling_mask;
+    rt_atomic_t count[16];
+    rt_uint32_t window_edges[16];
+    rt_uint32_t frequency[16]; // mHz, measured over the last complete window
+    rt_tick_t window_start;
+};
+#endif
+
+#ifdef PKG_USING_X9555_SOFT_PWM
+struct x9555_pwm;
+
+struct x9555_pwm_load
+{
+    rt_uint32_t writes_per_second; // output writes the current duty set needs
+    rt_uint32_t bytes_per_second;  // bus bytes including the address byte, upper bound
+    rt_uint32_t writes;            // output writes issued since start
+    rt_uint32_t late;              // edges serviced after their tick
+};
+#endif
+
+#ifdef PKG_USING_X9555_BUS_SCHEDULER
+struct x9555_bus_stats
+{
+    rt_uint32_t requests;   // transfers submitted by all devices on the bus
+    rt_uint32_t transfers;  // transfers put on the bus
+    rt_uint32_t batches;    // bus lock acquisitions
+    rt_uint32_t lock_us;    // time the combiners waited for the bus lock
+    rt_uint32_t busy_us;    // time the bus lock was held by the combiners
+    rt_uint32_t transfer_us; // time spent in transfers, busy_us - transfer_us is the idle time under the lock
+    rt_uint32_t completed[X9555_PRIO_NUM];
+    rt_uint32_t worst_latency_us[X9555_PRIO_NUM]; // queued -> completed
+};
+#endif
+
+#ifdef PKG_USING_X9555_TRACE
+/* 8 bytes, the binary dump is these records in little endian */
+struct x9555_trace_record
+{
+    rt_uint32_t timestamp; // x9555_timestamp_get() when the transfer completed
+    rt_uint8_t addr;       // 7-bit device address
+    rt_uint8_t reg;        // command byte
+    rt_uint8_t len;        // data bytes after the command byte
+    rt_uint8_t flags;      // X9555_TRACE_READ, X9555_TRACE_ERROR
+};
+#endif
+
+#ifdef PKG_USING_X9555_CAPTURE
+struct x9555_capture_stats
+{
+    rt_uint32_t samples;    // input pair samples read
+    rt_uint32_t reads;      // read transactions, a few bus clocks of gap lie between two
+    rt_uint32_t elapsed_us;
+    rt_uint32_t rate;       // effective samples per second, gaps included
+    rt_uint32_t runs;       // run-length records written, streaming only
+    rt_uint32_t bytes;      // bytes handed to the output, streaming only
+};
+
+typedef rt_size_t (*x9555_capture_output_t)(void *user, const void *data, rt_size_t size);
+#endif
+
+#ifdef PKG_USING_X9555_LATENCY
+struct x9555_latency_histogram
+{
+    rt_uint32_t count;
+    rt_uint32_t max_us;
+    rt_uint32_t bucket[PKG_X9555_LATENCY_BUCKETS]; // bucket n: [2^n, 2^(n + 1)) us
+};
+
+struct x9555_latency_stats
+{
+    struct x9555_latency_histogram histogram[X9555_LATENCY_NUM];
+};
+#endif
+
+#ifdef PKG_USING_X9555_LOCK_STATS
+struct x9555_lock_stats
+{
+    rt_uint32_t acquisitions;  // device lock takes by API calls and the worker
+    rt_uint32_t contended;     // takes which found the lock held
+    rt_uint64_t wait_us;       // total time spent waiting
+    rt_uint32_t worst_wait_us;
+};
+#endif
+
+#ifdef PKG_USING_X9555_IRQ_STORM
+struct x9555_storm_stats
+{
+    rt_uint32_t to_polling;   // interrupt storms detected, switches to polling
+    rt_uint32_t to_interrupt; // switches back after the line went quiet
+    rt_uint32_t polls;        // input pair reads made while polling
+    rt_bool_t polling;        // the interrupt is off right now
+};
+#endif
+
+#ifdef PKG_USING_X9555_SCRUBBER
+struct x9555_scrub_stats
+{
+    rt_uint32_t checks;     // register pairs read back
+    rt_uint32_t mismatches; // pairs found different from the shadow
+    rt_uint32_t repairs;    // repair bursts written successfully
+};
+#endif
+
+#ifdef X9555_USING_WORKER_POOL
+struct x9555_worker;
+#endif
+
+#ifdef PKG_USING_X9555_PIN_OPS
+struct x9555_pin_slot;
+#endif
+
+#ifdef PKG_USING_X9555_WRITE_BACK
+struct x9555_write_back;
+#endif
+
+struct x9555_bus
+{
+    rt_list_t list;
+    struct rt_i2c_bus_device *i2c;
+    rt_uint16_t ref_count;
+#ifdef PKG_USING_X9555_BUS_CPU
+    rt_uint8_t cpu;           // core of the service threads, X9555_CPU_ANY is unbound
+#endif
+#ifdef X9555_USING_WORKER_POOL
+    struct x9555_worker *worker;
+    rt_list_t worker_node;
+    rt_list_t devices;        // every device on the bus, for the poll periods
+    struct rt_spinlock run_lock;
+    rt_list_t run_queue;      // devices with work flagged
+#endif
+#ifdef PKG_USING_X9555_BUS_SCHEDULER
+    struct rt_spinlock spinlock;
+    rt_list_t queue[X9555_PRIO_NUM];
+    rt_bool_t busy;
+    rt_bool_t boosted;        // the combiner runs at boost_prio
+    rt_thread_t combiner;     // thread holding the I2C bus lock for the queue
+    rt_uint8_t combiner_prio; // its own priority, given back when it stops serving
+    rt_uint8_t boost_prio;
+    struct x9555_bus_stats stats;
+    rt_uint64_t lock_time;    // x9555_timestamp_get() units
+    rt_uint64_t busy_time;
+    rt_uint64_t transfer_time;
+    rt_uint32_t worst_latency[X9555_PRIO_NUM];
+#endif
+};
+
 struct x9555_device
 {
+#ifdef PKG_USING_X9555_DEVICE
+    struct rt_device parent;
+    rt_bool_t changed;        // input changed since the last rt_device_read(), under device->lock
+#endif
     struct rt_i2c_bus_device *i2c;
-    rt_mutex_t lock;
+    struct x9555_bus *bus;
+    struct rt_mutex lock;     // embedded, a device lock costs no heap block
     uint8_t device_address;
     rt_base_t device_interrupt_pin;
+
+#ifdef X9555_USING_WORKER_POOL
+    rt_uint32_t pending;      // worker event set, queued on the bus while non-zero, guarded by bus->run_lock
+    rt_list_t run_node;
+    rt_list_t node;
+    rt_tick_t poll_tick;
+#else
+    rt_thread_t worker;
+    rt_event_t event;
+#endif
+    rt_int32_t poll_period;
+    rt_tick_t irq_tick;
+    rt_bool_t irq_closing;    // set by deinit, the worker no longer arms the interrupt
+    rt_uint16_t input_state;
+    rt_uint16_t output_state;
+    rt_uint16_t polarity_state;
+    rt_uint16_t config_state;
+#ifdef PKG_USING_X9555_EVENT_RING
+    struct x9555_event_ring ring;
+#endif
+#ifdef PKG_USING_X9555_EDGE_COUNTER
+    struct x9555_edge_counter *edge;      // allocated by the first x9555_edge_counter_config()
+#endif
+#ifdef PKG_USING_X9555_SOFT_PWM
+    struct x9555_pwm *pwm;
+#endif
+#ifdef PKG_USING_X9555_IRQ_STORM
+    rt_tick_t storm_window_start;
+    rt_uint32_t storm_irqs;        // interrupts in the current window
+    rt_tick_t storm_poll_tick;
+    rt_tick_t storm_quiet_start;   // last input change or INT seen asserted while polling
+    struct x9555_storm_stats storm;
+#endif
+#ifdef PKG_USING_X9555_ISR_API
+    rt_atomic_t isr_pending; // output mask << 16 | output value, set from interrupt context
+    rt_uint8_t isr_retries;  // failed writes of the pending word in a row, worker only
+    struct rt_timer isr_retry_timer; // one-shot, wakes the worker for the next retry
+    rt_uint32_t isr_dropped; // output changes given up after X9555_ISR_RETRY_MAX failed writes
+#endif
+#ifdef PKG_USING_X9555_WRITE_BACK
+    struct x9555_write_back *write_back;  // RT_NULL writes through, see x9555_write_back_set()
+#endif
+#ifdef PKG_USING_X9555_LATENCY
+    rt_uint32_t irq_timestamp;
+    rt_uint32_t read_timestamp;
+    struct x9555_latency_stats latency;
+#endif
+#ifdef PKG_USING_X9555_PIN_WAIT
+    rt_list_t pin_waiters;
+#endif
+#ifdef PKG_USING_X9555_PIN_OPS
+    struct x9555_pin_slot *pin_slot;
+    rt_bool_t input_valid;    // input_state has been read from the chip
+#endif
+#ifdef PKG_USING_X9555_LOCK_STATS
+    struct x9555_lock_stats lock_stats;
+    rt_uint64_t lock_wait;       // x9555_timestamp_get() units
+    rt_uint32_t lock_worst_wait;
+#endif
+#ifdef PKG_USING_X9555_SCRUBBER
+    struct rt_timer scrub_timer;
+    rt_uint8_t scrub_index;
+    struct x9555_scrub_stats scrub;
+#endif
 };
 typedef struct x9555_device *x9555_device_t;
 
+#ifdef PKG_USING_X9555_PIN_GROUP
+struct x9555_group_pin
+{
+    x9555_device_t device;
+    rt_uint8_t pin;
+};
+typedef struct x9555_pin_group *x9555_pin_group_t;
+#endif
+
 extern x9555_device_t x9555_init(const char *interrupt_pin_name, const char *i2c_bus_name, uint8_t device_user_input_address);
 extern void x9555_deinit(x9555_device_t device);
+extern void x9555_footprint(void);
 extern void call_input_interrupt(void *args);
+#ifdef PKG_USING_X9555_SCRUBBER
+extern void call_scrub_repair(void *args);
+#endif
 
 extern rt_err_t x9555_port_config(x9555_device_t device, rt_uint8_t port, rt_uint8_t config_register, rt_uint8_t register_value);
 extern rt_err_t x9555_interrupt_clear(x9555_device_t device, char *interrupt_get_value);
@@ -106,4 +540,106 @@ extern rt_err_t x9555_pin_mode(x9555_device_t device, rt_uint8_t pin, rt_uint8_t
 extern rt_err_t x9555_pin_write(x9555_device_t device, rt_uint8_t pin, rt_uint8_t pin_state);
 extern rt_bool_t x9555_pin_read(x9555_device_t device, rt_uint8_t pin,rt_uint8_t pin_mode);
 
+extern rt_err_t x9555_port_write16(x9555_device_t device, rt_uint16_t port_value, rt_uint8_t order);
+extern rt_err_t x9555_set_mask16(x9555_device_t device, rt_uint16_t mask, rt_uint16_t value);
+extern rt_err_t x9555_port_write16_burst(x9555_device_t device, const rt_uint16_t *values, rt_size_t count);
+extern rt_err_t x9555_mode_mask16(x9555_device_t device, rt_uint16_t mask, rt_uint16_t inputs);
+extern rt_err_t x9555_input_read16(x9555_device_t device, rt_uint16_t *value);
+
+extern rt_uint32_t x9555_timestamp_get(void);
+extern rt_uint32_t x9555_timestamp_frequency(void);
+extern rt_uint32_t x9555_timestamp_to_us(rt_uint32_t timestamp);
+
+extern rt_err_t x9555_poll_period_set(x9555_device_t device, rt_uint32_t period_ms);
+
+#ifdef PKG_USING_X9555_BUS_SCHEDULER
+extern rt_err_t x9555_bus_stats_get(x9555_device_t device, struct x9555_bus_stats *stats, rt_bool_t reset);
+#endif
+
+#ifdef PKG_USING_X9555_PIN_WAIT
+extern rt_err_t x9555_pin_wait(x9555_device_t device, rt_uint16_t pin_mask, rt_uint16_t level_mask, rt_int32_t timeout);
+extern rt_err_t x9555_pin_wait_any(x9555_device_t device, rt_uint16_t pin_mask, rt_uint16_t level_mask, rt_int32_t timeout);
+#endif
+
+#ifdef PKG_USING_X9555_BUS_CPU
+extern rt_err_t x9555_bus_cpu_set(const char *i2c_bus_name, rt_uint8_t cpu);
+extern rt_uint8_t x9555_bus_cpu_get(x9555_device_t device);
+#endif
+
+#ifdef PKG_USING_X9555_PIN_OPS
+extern rt_base_t x9555_pin_number(x9555_device_t device, rt_uint8_t pin);
+#endif
+
+#ifdef PKG_USING_X9555_PIN_GROUP
+extern x9555_pin_group_t x9555_pin_group_create(const struct x9555_group_pin *pins, rt_uint8_t count);
+extern void x9555_pin_group_delete(x9555_pin_group_t group);
+extern rt_err_t x9555_pin_group_write(x9555_pin_group_t group, rt_uint32_t value);
+extern rt_err_t x9555_pin_group_read(x9555_pin_group_t group, rt_uint32_t *value);
+#endif
+
+#ifdef PKG_USING_X9555_IRQ_STORM
+extern rt_err_t x9555_storm_stats_get(x9555_device_t device, struct x9555_storm_stats *stats, rt_bool_t reset);
+#endif
+
+#ifdef PKG_USING_X9555_CAPTURE
+extern rt_err_t x9555_capture(x9555_device_t device, rt_uint16_t *samples, rt_size_t count, struct x9555_capture_stats *stats);
+extern rt_err_t x9555_capture_stream(x9555_device_t device, rt_uint32_t count, x9555_capture_output_t output, void *user,
+                                     struct x9555_capture_stats *stats);
+extern rt_size_t x9555_capture_ringbuffer(void *user, const void *data, rt_size_t size);
+#endif
+
+#ifdef PKG_USING_X9555_ISR_API
+extern rt_err_t x9555_pin_write_isr(x9555_device_t device, rt_uint8_t pin, rt_uint8_t pin_state);
+extern rt_err_t x9555_set_mask16_isr(x9555_device_t device, rt_uint16_t mask, rt_uint16_t value);
+extern rt_uint16_t x9555_input_isr(x9555_device_t device);
+extern rt_uint32_t x9555_isr_dropped(x9555_device_t device);
+#endif
+
+#ifdef PKG_USING_X9555_WRITE_BACK
+extern rt_err_t x9555_write_back_set(x9555_device_t device, rt_uint32_t window_us);
+extern rt_err_t x9555_flush(x9555_device_t device);
+#endif
+
+#ifdef PKG_USING_X9555_LATENCY
+extern rt_err_t x9555_latency_get(x9555_device_t device, struct x9555_latency_stats *stats, rt_bool_t reset);
+#endif
+
+#ifdef PKG_USING_X9555_LOCK_STATS
+extern rt_err_t x9555_lock_stats_get(x9555_device_t device, struct x9555_lock_stats *stats, rt_bool_t reset);
+#endif
+
+#ifdef PKG_USING_X9555_EVENT_RING
+extern rt_size_t x9555_event_read(x9555_device_t device, struct x9555_input_event *events, rt_size_t count, rt_int32_t timeout);
+extern rt_uint32_t x9555_event_dropped(x9555_device_t device);
+#endif
+
+#ifdef PKG_USING_X9555_EDGE_COUNTER
+extern rt_err_t x9555_edge_counter_config(x9555_device_t device, rt_uint8_t pin, rt_uint8_t edge);
+extern rt_uint32_t x9555_edge_counter_read(x9555_device_t device, rt_uint8_t pin, rt_bool_t reset);
+extern rt_uint32_t x9555_edge_frequency_get(x9555_device_t device, rt_uint8_t pin);
+#endif
+
+#ifdef PKG_USING_X9555_SOFT_PWM
+extern rt_err_t x9555_pwm_config(x9555_device_t device, rt_uint16_t frequency, rt_uint16_t resolution);
+extern rt_err_t x9555_pwm_set(x9555_device_t device, rt_uint8_t pin, rt_uint16_t duty);
+extern rt_err_t x9555_pwm_release(x9555_device_t device, rt_uint8_t pin);
+extern rt_err_t x9555_pwm_start(x9555_device_t device);
+extern rt_err_t x9555_pwm_stop(x9555_device_t device);
+extern rt_err_t x9555_pwm_bus_load(x9555_device_t device, struct x9555_pwm_load *load);
+#endif
+
+#ifdef PKG_USING_X9555_SCRUBBER
+extern rt_err_t x9555_scrub_budget_set(x9555_device_t device, rt_uint32_t bytes_per_second);
+extern rt_err_t x9555_scrub_stats_get(x9555_device_t device, struct x9555_scrub_stats *stats, rt_bool_t reset);
+#endif
+
+#ifdef PKG_USING_X9555_TRACE
+extern rt_size_t x9555_trace_snapshot(struct x9555_trace_record *records, rt_size_t count);
+extern void x9555_trace_clear(void);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     WennianYan   the first version.
+ */
+
+#ifndef __X9555_HPP__
+#define __X9555_HPP__
+
+#include "x9555.h"
+
+/*
+ * Header-only C++ layer: the port, mask and registers of a pin are template constants, so an
+ * invalid pin fails to compile and every access is one x9555_*_mask16() call with a constant mask.
+ *
+ *     x9555::Pin<x9555::Port::P1, 3> relay1(device);
+ *     x9555::Pin<x9555::Port::P1, 4> relay2(device);
+ *
+ *     (relay1 | relay2).set();   // x9555_set_mask16(device, 0x1800, 0x1800)
+ */
+namespace x9555
+{
+
+enum class Port : rt_uint8_t
+{
+    P0 = X9555_PORT_0,
+    P1 = X9555_PORT_1
+};
+
+namespace detail
+{
+/* 0 for an invalid pin, the static_assert in Pin reports it */
+constexpr rt_uint16_t pin_mask(Port port, unsigned bit)
+{
+    return ((bit < 8) && ((port == Port::P0) || (port == Port::P1)))
+           ? (rt_uint16_t)(1u << (bit + 8 * static_cast<unsigned>(port))) : 0;
+}
+}
+
+/* a set of pins on one device, bit 0 ~ 7 of Mask is port 0, bit 8 ~ 15 is port 1 */
+template <rt_uint16_t Mask>
+class PinSet
+{
+public:
+    static constexpr rt_uint16_t mask = Mask;
+
+    explicit constexpr PinSet(x9555_device_t device) : device_(device) {}
+
+    constexpr x9555_device_t device() const
+    {
+        return device_;
+    }
+
+    rt_err_t set() const
+    {
+        return x9555_set_mask16(device_, Mask, Mask);
+    }
+
+    rt_err_t clear() const
+    {
+        return x9555_set_mask16(device_, Mask, 0);
+    }
+
+    rt_err_t write(bool level) const
+    {
+        return x9555_set_mask16(device_, Mask, level ? Mask : 0);
+    }
+
+    /* levels is aligned like Mask, bits outside Mask are ignored */
+    rt_err_t assign(rt_uint16_t levels) const
+    {
+        return x9555_set_mask16(device_, Mask, levels);
+    }
+
+    rt_err_t output() const
+    {
+        return x9555_mode_mask16(device_, Mask, 0);
+    }
+
+    rt_err_t input() const
+    {
+        return x9555_mode_mask16(device_, Mask, Mask);
+    }
+
+    /* reads the input pair, levels gets the bits in Mask */
+    rt_err_t read(rt_uint16_t &levels) const
+    {
+        rt_err_t result = x9555_input_read16(device_, &levels);
+
+        levels &= Mask;
+        return result;
+    }
+
+    /* the output levels last written, no bus access */
+    rt_uint16_t driven() const
+    {
+        return device_->output_state & Mask;
+    }
+
+    /* both sides must be pins of the same device, the set keeps the device of the left side */
+    template <rt_uint16_t Other>
+    PinSet<Mask | Other> operator|(const PinSet<Other> &) const
+    {
+        static_assert((Mask & Other) == 0, "x9555 pin listed twice in a pin set");
+        return PinSet<Mask | Other>(device_);
+    }
+
+protected:
+    x9555_device_t device_;
+};
+
+template <rt_uint16_t Mask>
+constexpr rt_uint16_t PinSet<Mask>::mask;
+
+/* one pin, Bit 0 ~ 7 of Port */
+template <Port P, unsigned Bit>
+class Pin : public PinSet<detail::pin_mask(P, Bit)>
+{
+    static_assert((P == Port::P0) || (P == Port::P1), "x9555 port must be Port::P0 or Port::P1");
+    static_assert(Bit < 8, "x9555 pin bit must be 0 ~ 7");
+
+public:
+    static constexpr Port port = P;
+    static constexpr rt_uint8_t bit = Bit;
+    /* the pin number of the C API, X9555_IO_0_x or X9555_IO_1_x */
+    static constexpr rt_uint8_t number = (P == Port::P0) ? Bit : (X9555_IO_1_0 + Bit);
+    static constexpr rt_uint8_t input_register = X9555_Register_Input_Port_0 + static_cast<rt_uint8_t>(P);
+    static constexpr rt_uint8_t output_register = X9555_Register_Output_Port_0 + static_cast<rt_uint8_t>(P);
+    static constexpr rt_uint8_t polarity_register = X9555_Register_Polarity_Inversion_Port_0 + static_cast<rt_uint8_t>(P);
+    static constexpr rt_uint8_t config_register = X9555_Register_Configuration_Port_0 + static_cast<rt_uint8_t>(P);
+
+    explicit constexpr Pin(x9555_device_t device) : PinSet<detail::pin_mask(P, Bit)>(device) {}
+
+    rt_err_t read(bool &level) const
+    {
+        rt_uint16_t levels;
+        rt_err_t result = PinSet<detail::pin_mask(P, Bit)>::read(levels);
+
+        level = (levels != 0);
+        return result;
+    }
+};
+
+template <Port P, unsigned Bit> constexpr Port Pin<P, Bit>::port;
+template <Port P, unsigned Bit> constexpr rt_uint8_t Pin<P, Bit>::bit;
+template <Port P, unsigned Bit> constexpr rt_uint8_t Pin<P, Bit>::number;
+template <Port P, unsigned Bit> constexpr rt_uint8_t Pin<P, Bit>::input_register;
+template <Port P, unsigned Bit> constexpr rt_uint8_t Pin<P, Bit>::output_register;
+template <Port P, unsigned Bit> constexpr rt_uint8_t Pin<P, Bit>::polarity_register;
+template <Port P, unsigned Bit> constexpr rt_uint8_t Pin<P, Bit>::config_register;
+
+}
+
+#endif